@@ -0,0 +1,212 @@
+#include "aleatoire.hpp"
+#include <fstream>
+#include <cstring>
+
+static const char SIGNATURE_TIRAGES[4] = { 'A', 'T', 'C', 'T' };
+static const uint32_t VERSION_TIRAGES = 1;
+// Nom d'une entrée externe (de la forme "trafic.nb_avions")
+static const uint32_t LONGUEUR_CLE_MAX = 1024;
+
+// SplitMix64 : mélange de la graine et pas du générateur, identique sur toutes les plateformes
+static uint64_t melanger(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static const uint64_t PAS_SPLITMIX = 0x9E3779B97F4A7C15ULL;
+
+FluxAleatoire::FluxAleatoire() : etat_(0), piste_(nullptr), journal_(nullptr) {
+}
+
+FluxAleatoire::FluxAleatoire(uint64_t graine, uint32_t idFlux, JournalTirages* journal)
+    : etat_(melanger(graine ^ melanger(idFlux + PAS_SPLITMIX))),
+    piste_(journal ? journal->piste(idFlux) : nullptr), journal_(journal) {
+}
+
+uint32_t FluxAleatoire::suivant() {
+    etat_ += PAS_SPLITMIX;
+    uint32_t valeur = static_cast<uint32_t>(melanger(etat_) >> 32);
+    if (piste_) valeur = journal_->tirer(*piste_, valeur);
+    return valeur;
+}
+
+static int borner(uint32_t valeur, int borne) {
+    return static_cast<int>((static_cast<uint64_t>(valeur) * static_cast<uint32_t>(borne)) >> 32);
+}
+
+int FluxAleatoire::entier(int borne) {
+    return borner(suivant(), borne);
+}
+
+int FluxAleatoire::apercuEntier(size_t rang, int borne) const {
+    uint32_t valeur = static_cast<uint32_t>(melanger(etat_ + (rang + 1) * PAS_SPLITMIX) >> 32);
+    if (piste_) valeur = journal_->apercu(*piste_, rang, valeur);
+    return borner(valeur, borne);
+}
+
+void FluxAleatoire::sauter(size_t nb) {
+    for (size_t i = 0; i < nb; ++i) suivant();
+}
+
+JournalTirages::JournalTirages(uint64_t graine)
+    : mode_(Mode::LIBRE), graine_(graine), nbDivergences_(0) {
+}
+
+void JournalTirages::reinitialiser(uint64_t graine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mode_ == Mode::REJEU) mode_ = Mode::LIBRE;
+    graine_ = graine;
+    entrees_.clear();
+    pistes_.clear();
+    nbDivergences_ = 0;
+}
+
+void JournalTirages::enregistrer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // En rejeu, les pistes chargées sont déjà gardées (et resauvegardées telles quelles)
+    if (mode_ == Mode::LIBRE) mode_ = Mode::ENREGISTREMENT;
+}
+
+JournalTirages::Mode JournalTirages::getMode() const {
+    return mode_;
+}
+
+uint64_t JournalTirages::getGraine() const {
+    return graine_;
+}
+
+unsigned long long JournalTirages::getNbDivergences() const {
+    return nbDivergences_;
+}
+
+double JournalTirages::entree(const std::string& cle, double valeur) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mode_ == Mode::REJEU) {
+        auto it = entrees_.find(cle);
+        if (it != entrees_.end()) return it->second;
+    }
+    entrees_[cle] = valeur;
+    return valeur;
+}
+
+PisteTirages* JournalTirages::piste(uint32_t idFlux) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (mode_ == Mode::LIBRE) return nullptr;
+    std::unique_ptr<PisteTirages>& piste = pistes_[idFlux];
+    if (!piste) piste = std::make_unique<PisteTirages>();
+    return piste.get();
+}
+
+// Appelé sans verrou : une piste n'appartient qu'au flux qui l'a ouverte
+uint32_t JournalTirages::tirer(PisteTirages& piste, uint32_t valeurGeneree) {
+    if (mode_ == Mode::REJEU) {
+        if (piste.curseur < piste.valeurs.size()) return piste.valeurs[piste.curseur++];
+        nbDivergences_.fetch_add(1, std::memory_order_relaxed);
+        return valeurGeneree;
+    }
+    piste.valeurs.push_back(valeurGeneree);
+    return valeurGeneree;
+}
+
+uint32_t JournalTirages::apercu(const PisteTirages& piste, size_t rang, uint32_t valeurGeneree) const {
+    if (mode_ == Mode::REJEU && piste.curseur + rang < piste.valeurs.size()) return piste.valeurs[piste.curseur + rang];
+    return valeurGeneree;
+}
+
+// Format : signature, version, graine, entrées (nom, valeur), puis pistes (id, nombre, valeurs)
+bool JournalTirages::sauvegarder(const std::string& chemin) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream fichier(chemin, std::ios::binary);
+    if (!fichier.is_open()) return false;
+
+    auto ecrire = [&fichier](const auto& valeur) {
+        fichier.write(reinterpret_cast<const char*>(&valeur), sizeof(valeur));
+    };
+
+    fichier.write(SIGNATURE_TIRAGES, sizeof(SIGNATURE_TIRAGES));
+    ecrire(VERSION_TIRAGES);
+    ecrire(graine_);
+
+    ecrire(static_cast<uint32_t>(entrees_.size()));
+    for (const auto& [cle, valeur] : entrees_) {
+        ecrire(static_cast<uint32_t>(cle.size()));
+        fichier.write(cle.data(), cle.size());
+        ecrire(valeur);
+    }
+
+    ecrire(static_cast<uint32_t>(pistes_.size()));
+    for (const auto& [id, piste] : pistes_) {
+        ecrire(id);
+        ecrire(static_cast<uint64_t>(piste->valeurs.size()));
+        fichier.write(reinterpret_cast<const char*>(piste->valeurs.data()), piste->valeurs.size() * sizeof(uint32_t));
+    }
+    return static_cast<bool>(fichier);
+}
+
+bool JournalTirages::charger(const std::string& chemin) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ifstream fichier(chemin, std::ios::binary);
+    if (!fichier.is_open()) return false;
+
+    // Les longueurs lues sont bornées par ce qui reste du fichier avant toute allocation :
+    // un fichier tronqué ou forgé est refusé au lieu d'épuiser la mémoire
+    fichier.seekg(0, std::ios::end);
+    const std::streamoff tailleFichier = fichier.tellg();
+    fichier.seekg(0, std::ios::beg);
+    auto restant = [&fichier, tailleFichier]() -> uint64_t {
+        std::streamoff position = fichier.tellg();
+        return (position < 0 || position > tailleFichier) ? 0 : static_cast<uint64_t>(tailleFichier - position);
+    };
+
+    auto lire = [&fichier](auto& valeur) {
+        fichier.read(reinterpret_cast<char*>(&valeur), sizeof(valeur));
+    };
+
+    char signature[sizeof(SIGNATURE_TIRAGES)];
+    uint32_t version = 0;
+    fichier.read(signature, sizeof(signature));
+    lire(version);
+    if (!fichier || std::memcmp(signature, SIGNATURE_TIRAGES, sizeof(signature)) != 0 || version != VERSION_TIRAGES) {
+        return false;
+    }
+
+    uint64_t graine = 0;
+    uint32_t nbEntrees = 0;
+    lire(graine);
+    lire(nbEntrees);
+
+    std::map<std::string, double> entrees;
+    for (uint32_t i = 0; i < nbEntrees && fichier; ++i) {
+        uint32_t taille = 0;
+        double valeur = 0;
+        lire(taille);
+        if (!fichier || taille > LONGUEUR_CLE_MAX || taille > restant()) return false;
+        std::string cle(taille, '\0');
+        fichier.read(cle.data(), taille);
+        lire(valeur);
+        entrees[cle] = valeur;
+    }
+
+    uint32_t nbPistes = 0;
+    lire(nbPistes);
+    std::map<uint32_t, std::unique_ptr<PisteTirages>> pistes;
+    for (uint32_t i = 0; i < nbPistes && fichier; ++i) {
+        uint32_t id = 0;
+        uint64_t nbValeurs = 0;
+        lire(id);
+        lire(nbValeurs);
+        if (!fichier || nbValeurs > restant() / sizeof(uint32_t)) return false;
+        auto piste = std::make_unique<PisteTirages>();
+        piste->valeurs.resize(nbValeurs);
+        fichier.read(reinterpret_cast<char*>(piste->valeurs.data()), nbValeurs * sizeof(uint32_t));
+        pistes[id] = std::move(piste);
+    }
+    if (!fichier) return false;
+
+    mode_ = Mode::REJEU;
+    graine_ = graine;
+    entrees_ = std::move(entrees);
+    pistes_ = std::move(pistes);
+    return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+// Tirages aléatoires reproductibles : chaque avion (et le générateur de trafic) a son propre
+// flux, dérivé de la graine du scénario et d'un identifiant stable. Un flux n'est utilisé que
+// par un thread à la fois, il n'y a donc ni verrou ni état global comme avec std::rand.
+
+class JournalTirages;
+
+// Suite des valeurs brutes d'un flux, enregistrées ou à rejouer
+struct PisteTirages {
+    std::vector<uint32_t> valeurs;
+    size_t curseur = 0;
+};
+
+class FluxAleatoire {
+private:
+    uint64_t etat_;
+    PisteTirages* piste_;     // nullptr : tirages libres, ni enregistrés ni rejoués
+    JournalTirages* journal_;
+
+public:
+    FluxAleatoire();
+    FluxAleatoire(uint64_t graine, uint32_t idFlux, JournalTirages* journal = nullptr);
+
+    uint32_t suivant();
+    // Entier uniforme dans [0, borne)
+    int entier(int borne);
+
+    // Ce que renverrait entier(borne) au rang-ième tirage à venir (0 : le prochain), sans rien
+    // consommer : pour savoir d'avance combien de tirages pas à pas précèdent un événement
+    int apercuEntier(size_t rang, int borne) const;
+    // Consomme nb tirages comme autant d'appels à suivant() (enregistrés ou rejoués de même)
+    void sauter(size_t nb);
+};
+
+// Enregistre tous les tirages et les entrées externes d'une exécution, ou les rejoue depuis un
+// fichier : en rejeu, chaque flux renvoie exactement les valeurs enregistrées, quel que soit
+// l'ordre dans lequel les threads s'exécutent. En mode LIBRE (par défaut), les flux n'ont pas de
+// piste : aucun tirage n'est gardé, et la mémoire ne croît pas avec la durée de l'exécution.
+class JournalTirages {
+public:
+    enum class Mode { LIBRE, ENREGISTREMENT, REJEU };
+
+private:
+    Mode mode_;
+    uint64_t graine_;
+    std::map<std::string, double> entrees_;
+    std::map<uint32_t, std::unique_ptr<PisteTirages>> pistes_;
+    std::mutex mutex_;
+    std::atomic<unsigned long long> nbDivergences_;
+
+public:
+    explicit JournalTirages(uint64_t graine);
+
+    // Repart d'un enregistrement vide avec une nouvelle graine (avant tout tirage) ; un rejeu
+    // chargé est abandonné, un enregistrement demandé est conservé
+    void reinitialiser(uint64_t graine);
+    // Garde désormais tous les tirages, pour sauvegarder (avant tout tirage)
+    void enregistrer();
+
+    // Charge un enregistrement et passe en mode REJEU ; false si le fichier est illisible
+    bool charger(const std::string& chemin);
+    bool sauvegarder(const std::string& chemin);
+
+    Mode getMode() const;
+    uint64_t getGraine() const;
+    // Tirages demandés en rejeu au-delà de ce qui avait été enregistré (l'exécution a divergé)
+    unsigned long long getNbDivergences() const;
+
+    // Entrée externe (paramètre de lancement...) : enregistrée telle quelle, ou remplacée
+    // par la valeur enregistrée en rejeu
+    double entree(const std::string& cle, double valeur);
+
+    // nullptr en mode LIBRE : le flux tire sans rien garder
+    PisteTirages* piste(uint32_t idFlux);
+    uint32_t tirer(PisteTirages& piste, uint32_t valeurGeneree);
+    // Valeur que tirer renverra au rang-ième tirage à venir de la piste, sans la consommer
+    uint32_t apercu(const PisteTirages& piste, size_t rang, uint32_t valeurGeneree) const;
+};
@@ -0,0 +1,129 @@
+#include "allocateurparkings.hpp"
+#include <bit>
+#include <numeric>
+
+AllocateurParkings::AllocateurParkings(std::vector<Parking>& parkings, const Position& posPiste)
+    : nbMots_((parkings.size() + 63) / 64), nbResumes_((nbMots_ + 63) / 64),
+    politique_(PolitiqueParking::PLUS_PROCHE_PISTE) {
+    // Rangs dans l'ordre des distances à la piste ; à distance égale, l'ordre de déclaration
+    std::vector<size_t> ordre(parkings.size());
+    std::iota(ordre.begin(), ordre.end(), 0);
+    std::stable_sort(ordre.begin(), ordre.end(), [&](size_t a, size_t b) {
+        return parkings[a].getDistancePiste(posPiste) < parkings[b].getDistancePiste(posPiste);
+    });
+
+    for (Ensemble& ensemble : ensembles_) {
+        ensemble.mots = std::make_unique<std::atomic<uint64_t>[]>(nbMots_);
+        ensemble.resumes = std::make_unique<std::atomic<uint64_t>[]>(nbResumes_);
+        for (size_t m = 0; m < nbMots_; ++m) ensemble.mots[m] = 0;
+        for (size_t r = 0; r < nbResumes_; ++r) ensemble.resumes[r] = 0;
+    }
+
+    parRang_.reserve(parkings.size());
+    for (size_t i : ordre) {
+        uint32_t rang = static_cast<uint32_t>(parRang_.size());
+        Parking& parking = parkings[i];
+        parking.allocateur_ = this;
+        parking.rang_ = rang;
+        parRang_.push_back(&parking);
+
+        // Tous les parkings sont libres au départ
+        Ensemble& ensemble = ensembles_[static_cast<int>(parking.gabarit_)];
+        ensemble.mots[rang / 64] |= 1ULL << (rang % 64);
+        ensemble.resumes[rang / 4096] |= 1ULL << ((rang / 64) % 64);
+    }
+}
+
+void AllocateurParkings::setPolitique(PolitiqueParking politique) {
+    politique_ = politique;
+}
+
+uint32_t AllocateurParkings::premierLibre(const Ensemble& ensemble) const {
+    for (size_t r = 0; r < nbResumes_; ++r) {
+        uint64_t resume = ensemble.resumes[r].load(std::memory_order_acquire);
+        while (resume) {
+            size_t m = r * 64 + std::countr_zero(resume);
+            uint64_t mot = ensemble.mots[m].load(std::memory_order_acquire);
+            if (mot) return static_cast<uint32_t>(m * 64 + std::countr_zero(mot));
+            // Résumé en retard sur une réservation concurrente : mot suivant
+            resume &= resume - 1;
+        }
+    }
+    return AUCUN;
+}
+
+// Baisse le bit du parking ; false si un autre pilote l'a pris entre-temps
+bool AllocateurParkings::prendre(Ensemble& ensemble, uint32_t rang) {
+    size_t m = rang / 64;
+    uint64_t bit = 1ULL << (rang % 64);
+    uint64_t ancien = ensemble.mots[m].fetch_and(~bit, std::memory_order_acq_rel);
+    if (!(ancien & bit)) return false;
+
+    if ((ancien & ~bit) == 0) {
+        // Mot vide : on efface son bit de résumé, puis on le relève si une libération
+        // concurrente a rempli le mot entre-temps
+        uint64_t bitResume = 1ULL << (m % 64);
+        ensemble.resumes[m / 64].fetch_and(~bitResume, std::memory_order_acq_rel);
+        if (ensemble.mots[m].load(std::memory_order_acquire) != 0) {
+            ensemble.resumes[m / 64].fetch_or(bitResume, std::memory_order_acq_rel);
+        }
+    }
+    return true;
+}
+
+uint32_t AllocateurParkings::choisir(int gabaritMin, int& gabarit) const {
+    uint32_t meilleur = AUCUN;
+    bool ajuste = (politique_.load(std::memory_order_relaxed) == PolitiqueParking::TAILLE_AJUSTEE);
+
+    // Au plus NB_GABARITS recherches : le plus proche de chaque gabarit acceptable
+    for (int g = gabaritMin; g < NB_GABARITS; ++g) {
+        uint32_t rang = premierLibre(ensembles_[g]);
+        if (rang < meilleur) {
+            meilleur = rang;
+            gabarit = g;
+            if (ajuste) break;
+        }
+    }
+    return meilleur;
+}
+
+Parking* AllocateurParkings::reserver(CategorieAvion categorie) {
+    int gabarit = 0;
+    for (;;) {
+        uint32_t rang = choisir(static_cast<int>(categorie), gabarit);
+        if (rang == AUCUN) return nullptr;
+        if (prendre(ensembles_[gabarit], rang)) return parRang_[rang];
+    }
+}
+
+void AllocateurParkings::liberer(const Parking& parking) {
+    Ensemble& ensemble = ensembles_[static_cast<int>(parking.gabarit_)];
+    uint32_t rang = parking.rang_;
+    size_t m = rang / 64;
+    // Bit du parking avant celui du résumé : un lecteur qui voit le résumé trouve le parking
+    ensemble.mots[m].fetch_or(1ULL << (rang % 64), std::memory_order_acq_rel);
+    ensemble.resumes[m / 64].fetch_or(1ULL << (m % 64), std::memory_order_acq_rel);
+}
+
+bool AllocateurParkings::estOccupe(const Parking& parking) const {
+    const Ensemble& ensemble = ensembles_[static_cast<int>(parking.gabarit_)];
+    uint32_t rang = parking.rang_;
+    return !(ensemble.mots[rang / 64].load(std::memory_order_acquire) & (1ULL << (rang % 64)));
+}
+
+bool AllocateurParkings::disponible(CategorieAvion categorie) const {
+    for (int g = static_cast<int>(categorie); g < NB_GABARITS; ++g) {
+        if (premierLibre(ensembles_[g]) != AUCUN) return true;
+    }
+    return false;
+}
+
+size_t AllocateurParkings::getNombreLibres() const {
+    size_t total = 0;
+    for (const Ensemble& ensemble : ensembles_) {
+        for (size_t m = 0; m < nbMots_; ++m) {
+            total += std::popcount(ensemble.mots[m].load(std::memory_order_relaxed));
+        }
+    }
+    return total;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "avion.hpp"
+
+// Parkings libres d'une TWR, sans verrou : un ensemble de bits par gabarit, où le bit r
+// désigne le parking de rang r dans l'ordre des distances à la piste (rang 0 = le plus proche).
+// Le premier bit levé d'un ensemble est donc son parking libre le plus proche de la piste ;
+// un mot de résumé par tranche de 64 mots indique ceux qui ont encore des bits levés.
+// Réserver et libérer sont des opérations atomiques sur un mot : les pilotes les appellent
+// directement, sans passer par le verrou de la TWR.
+class AllocateurParkings {
+private:
+    static constexpr int NB_GABARITS = 3;
+    static constexpr uint32_t AUCUN = UINT32_MAX;
+
+    struct Ensemble {
+        std::unique_ptr<std::atomic<uint64_t>[]> mots;
+        std::unique_ptr<std::atomic<uint64_t>[]> resumes;
+    };
+
+    std::vector<Parking*> parRang_;
+    size_t nbMots_;
+    size_t nbResumes_;
+    Ensemble ensembles_[NB_GABARITS];
+    std::atomic<PolitiqueParking> politique_;
+
+    uint32_t premierLibre(const Ensemble& ensemble) const;
+    bool prendre(Ensemble& ensemble, uint32_t rang);
+    // Rang candidat selon la politique, et l'ensemble qui le contient ; AUCUN si tout est pris
+    uint32_t choisir(int gabaritMin, int& gabarit) const;
+
+public:
+    // Les parkings doivent rester en place (vecteur non redimensionné) tant que l'allocateur vit
+    AllocateurParkings(std::vector<Parking>& parkings, const Position& posPiste);
+
+    AllocateurParkings(const AllocateurParkings&) = delete;
+    AllocateurParkings& operator=(const AllocateurParkings&) = delete;
+
+    void setPolitique(PolitiqueParking politique);
+
+    // Réserve un parking libre dont le gabarit accepte categorie ; nullptr si aucun
+    Parking* reserver(CategorieAvion categorie);
+    void liberer(const Parking& parking);
+
+    bool estOccupe(const Parking& parking) const;
+    bool disponible(CategorieAvion categorie) const;
+    size_t getNombreLibres() const;
+};
@@ -1,6 +1,14 @@
 ﻿#include "avion.hpp"
+#include "gestionnairearrivees.hpp"
 
-APP::APP(TWR* tour) : twr_(tour) {}
+APP::APP(TWR* tour) : twr_(tour), nbRefus_(0), nbMisesEnAttente_(0), avionUrgence_(nullptr) {
+    if (twr_) {
+        twr_->abonner(&signal_);
+        arrivees_ = std::make_unique<GestionnaireArrivees>(twr_);
+    }
+}
+
+APP::~APP() = default;
 
 size_t APP::getNombreAvionsDansZone() const { 
     return avionsDansZone_.size(); 
@@ -11,30 +19,18 @@ void APP::ajouterAvion(Avion* avion) {
     if (std::find(avionsDansZone_.begin(), avionsDansZone_.end(), avion) == avionsDansZone_.end()) {
         avionsDansZone_.push_back(avion);
         std::cout << "[APP] " << avion->getNom() << " entre dans la zone d'approche.\n";
+        signaler();
     }
-    std::stringstream ss;
-    ss << "L'avion " << *avion << " est pris en charge par l'APP";
-    Logger::getInstance().log("APP", "Prise en charge", ss.str());
+    Logger::getInstance().evenement(ActeurLog::APP, ActionLog::PRISE_EN_CHARGE, avion->getId(), 0, avion->getCarburant());
 }
 
 void APP::assignerTrajectoireApproche(Avion* avion) {
     std::lock_guard<std::recursive_mutex> lock(mutexAPP_);
     if (!twr_) return;
 
-    Position refPiste = twr_->getPositionPiste();
-
-    float px = refPiste.getX();
-    float py = refPiste.getY();
-
-    // Modification : Descente par paliers depuis l'altitude de croisière
-    std::vector<Position> traj = {
-        Position(px, py + 20000, 4000), // 20km out, 4000m
-        Position(px, py + 10000, 2000), // 10km out, 2000m
-        Position(px, py + 3000, 1000),  // 3km out, 1000m
-        Position(px, py + 1000, 500)    // Finale
-    };
-
-    avion->setTrajectoire(traj);
+    // Créneau d'atterrissage réservé dès la prise en charge, retard absorbé pendant l'approche
+    arrivees_->planifier(avion, trajectoire_);
+    avion->setTrajectoire(trajectoire_);
     avion->setEtat(EtatAvion::EN_APPROCHE);
     std::cout << "[APP] Trajectoire d'approche transmise a " << avion->getNom() << ".\n";
 }
@@ -44,28 +40,21 @@ void APP::mettreEnAttente(Avion* avion) {
 
     avion->setEtat(EtatAvion::EN_ATTENTE_ATTERRISSAGE);
     fileAttenteAtterrissage_.push(avion);
+    ++nbMisesEnAttente_;
 
 
-    std::vector<Position> cercle;
     Position centre = twr_->getPositionPiste();
     
     // Modification : Le rayon du circuit d'attente correspond maintenant au rayon de contrôle de l'APP
     float rayon = avion->getDestination()->rayonControle;
     float altitudeAttente = 2000.0f; 
 
-    for (int tour = 0; tour < 5; ++tour) {
-        for (int angleDeg = 0; angleDeg < 360; angleDeg += 10) {
-            float angleRad = angleDeg * (3.14159f / 180.0f);
-            float x = centre.getX() + rayon * std::cos(angleRad);
-            float y = centre.getY() + rayon * std::sin(angleRad);
-            cercle.push_back(Position(x, y, altitudeAttente));
-        }
-    }
+    // 5 tours, un point tous les 10 degrés, calculés au fil de l'eau par l'avion
+    avion->setCircuitAttente(CircuitAttente{ centre, rayon, altitudeAttente, 5 });
 
-    avion->setTrajectoire(cercle);
-
-    Logger::getInstance().log("APP", "Mise en attente (atterrissage refusé)", "Avion " + avion->getNom() + " est en attente d'atterrissage.");
+    Logger::getInstance().evenement(ActeurLog::APP, ActionLog::MISE_EN_ATTENTE, avion->getId());
     std::cout << "[APP] " << avion->getNom() << " entre en circuit d'attente.\n";
+    signaler();
 }
 
 bool APP::demanderAutorisationAtterrissage(Avion* avion) {
@@ -73,27 +62,29 @@ bool APP::demanderAutorisationAtterrissage(Avion* avion) {
     if (!twr_) return false;
 
     if (twr_->autoriserAtterrissage(avion)) {
-        std::vector<Position> finale;
-        finale.push_back(twr_->getPositionPiste());
-        avion->setTrajectoire(finale);
+        avion->setTrajectoire({ twr_->getPositionPiste(avion) });
 
         auto it = std::find(avionsDansZone_.begin(), avionsDansZone_.end(), avion);
         if (it != avionsDansZone_.end()) {
             avionsDansZone_.erase(it);
         }
 
-        std::stringstream ss;
-        ss << "Autorisation d'atterrir pour " << *avion;
-        Logger::getInstance().log("APP", "Autorisation atterrissage", ss.str());
+        Logger::getInstance().evenement(ActeurLog::APP, ActionLog::AUTORISATION_ATTERRISSAGE, avion->getId(), 0, avion->getCarburant());
 
         return true;
     }
+    ++nbRefus_;
     return false;
 }
 
 void APP::mettreAJour() {
     std::lock_guard<std::recursive_mutex> lock(mutexAPP_);
 
+    // Un avion en urgence qui s'écrase avant la piste ne libérera jamais la TWR
+    if (avionUrgence_ && avionUrgence_->getEtat() == EtatAvion::TERMINE) {
+        abandonnerUrgence();
+    }
+
     for (Avion* avion : avionsDansZone_) {
         if (avion->estEnUrgence() && avion->getEtat() == EtatAvion::EN_ATTENTE_ATTERRISSAGE) {
 
@@ -109,6 +100,8 @@ void APP::mettreAJour() {
 
         if (avionEnAttente->getEtat() != EtatAvion::EN_ATTENTE_ATTERRISSAGE) {
             fileAttenteAtterrissage_.pop();
+            // Le suivant de la file sera examiné au prochain passage, sans attendre d'événement
+            signaler();
             return;
         }
 
@@ -122,15 +115,42 @@ void APP::mettreAJour() {
 
     for (Avion* avion : avionsDansZone_) {
         if (avion->estEnUrgence() && !twr_->estUrgenceEnCours()) {
-            if (avion->getEtat() != EtatAvion::ATTERRISSAGE && avion->getEtat() != EtatAvion::EN_APPROCHE) {
+            // Un avion écrasé dans la zone n'est pas repris en urgence
+            EtatAvion etat = avion->getEtat();
+            if (etat != EtatAvion::ATTERRISSAGE && etat != EtatAvion::EN_APPROCHE && etat != EtatAvion::TERMINE) {
                 gererUrgence(avion);
             }
         }
     }
 }
 
+void APP::abandonnerUrgence() {
+    avionUrgence_ = nullptr;
+    if (twr_->estUrgenceEnCours()) {
+        std::cout << "[APP] L'avion en urgence a disparu des radars. Reprise du trafic.\n";
+        twr_->setUrgenceEnCours(false);
+    }
+}
+
+void APP::oublier(const Avion* avion) {
+    std::lock_guard<std::recursive_mutex> lock(mutexAPP_);
+    std::erase(avionsDansZone_, avion);
+
+    // std::queue n'a pas de retrait : la file est recopiée sans l'avion, dans le même ordre
+    std::queue<Avion*> file;
+    for (; !fileAttenteAtterrissage_.empty(); fileAttenteAtterrissage_.pop()) {
+        if (fileAttenteAtterrissage_.front() != avion) file.push(fileAttenteAtterrissage_.front());
+    }
+    fileAttenteAtterrissage_.swap(file);
+
+    if (avionUrgence_ == avion) abandonnerUrgence();
+}
+
 void APP::gererUrgence(Avion* avion) {
     twr_->setUrgenceEnCours(true);
+    avionUrgence_ = avion;
+    // Trajectoire directe : le créneau prévu ne sera pas tenu
+    arrivees_->annuler(avion);
 
     std::string typeTxt = "INCONNU";
     switch (avion->getTypeUrgence()) {
@@ -143,14 +163,29 @@ void APP::gererUrgence(Avion* avion) {
 
     Position posPiste = twr_->getPositionPiste();
 
-    std::vector<Position> trajectoireDirecte;
+    avion->setTrajectoire({ Position(posPiste.getX(), posPiste.getY(), 1000), posPiste });
+    avion->setEtat(EtatAvion::EN_APPROCHE);
 
+    std::cout << "[APP] Trajectoire directe d'urgence transmise a " << avion->getNom() << ".\n";
+}
 
-    trajectoireDirecte.push_back(Position(posPiste.getX(), posPiste.getY(), 1000)); 
-    trajectoireDirecte.push_back(posPiste);
+StatistiquesArrivee APP::getStatistiquesArrivee() const {
+    std::lock_guard<std::recursive_mutex> lock(mutexAPP_);
+    StatistiquesArrivee stats{};
+    if (arrivees_) arrivees_->completer(stats);
+    stats.nbRefus = nbRefus_;
+    stats.nbMisesEnAttente = nbMisesEnAttente_;
+    return stats;
+}
 
-    avion->setTrajectoire(trajectoireDirecte);
-    avion->setEtat(EtatAvion::EN_APPROCHE);
+long long APP::delaiReveil(long long delaiMaxMs) const {
+    return twr_ ? twr_->delaiReveil(delaiMaxMs) : delaiMaxMs;
+}
 
-    std::cout << "[APP] Trajectoire directe d'urgence transmise a " << avion->getNom() << ".\n";
+SignalHorloge& APP::getSignal() {
+    return signal_;
+}
+
+void APP::signaler() {
+    HorlogeSimulation::getInstance().signaler(signal_);
 }
@@ -1,43 +1,100 @@
 ﻿#include "avion.hpp"
+#include "etatflotte.hpp"
+#include "instantane.hpp"
+#include "cinematique.hpp"
+#include <cstring>
+
+static std::atomic<uint32_t> prochainIdAvion(1);
 
 Avion::Avion(std::string n, float v, float vSol, float c, float conso, float dureeStat, Position pos)
-    : nom_(n), vitesse_(v), vitesseSol_(vSol), carburant_(c), conso_(conso),
-    dureeStationnement_(dureeStat), pos_(pos), etat_(EtatAvion::STATIONNE),
-    parking_(nullptr), destination_(nullptr), typeUrgence_(TypeUrgence::AUCUNE) {
+    : id_(prochainIdAvion++), vitesse_(v), vitesseSol_(vSol), conso_(conso),
+    emplacement_(EtatFlotte::getInstance().allouer()), rang_(emplacement_ % TAILLE_PAGE_FLOTTE),
+    page_(&EtatFlotte::getInstance().reserver(emplacement_)), nom_(n),
+    curseurTrajectoire_(0), enCircuitAttente_(false),
+    circuit_{ Position(), 0.f, 0.f, 0 }, indiceCircuit_(0), dureeStationnement_(dureeStat),
+    parking_(nullptr), categorie_(CategorieAvion::MOYEN), version_(0) {
+    initialiserVol(pos, c);
+}
+
+Avion::~Avion() {
+    EtatFlotte::getInstance().liberer(emplacement_);
+}
+
+void Avion::reprendre(const std::string& n, float v, float vSol, float c, float conso, float dureeStat, const Position& pos) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    id_ = prochainIdAvion++;
+    vitesse_ = v;
+    vitesseSol_ = vSol;
+    conso_ = conso;
+    nom_ = n;
+    // clear garde la capacité : la trajectoire du vol précédent sert de tampon aux suivantes
+    trajectoire_.clear();
+    curseurTrajectoire_ = 0;
+    enCircuitAttente_ = false;
+    circuit_ = CircuitAttente{ Position(), 0.f, 0.f, 0 };
+    indiceCircuit_ = 0;
+    pointCircuit_ = Position();
+    dureeStationnement_ = dureeStat;
+    parking_ = nullptr;
+    categorie_ = CategorieAvion::MOYEN;
+    ++version_;
+    initialiserVol(pos, c);
+}
+
+void Avion::initialiserVol(const Position& pos, float carburant) {
+    page_->setPosition(rang_, pos);
+    page_->setCarburant(rang_, carburant);
+    page_->setEtat(rang_, EtatAvion::STATIONNE);
+    page_->setUrgence(rang_, TypeUrgence::AUCUNE);
+    page_->setDestination(rang_, nullptr);
+    publierCible();
+    Logger::getInstance().nommerAvion(id_, nom_);
+}
+
+uint32_t Avion::getId() const {
+    return id_;
+}
+
+uint32_t Avion::getEmplacement() const {
+    return emplacement_;
 }
 
 std::string Avion::getNom() const {
     return nom_;
 }
 
+// Performances fixées à la construction (ou par reprendre) : lues sans verrou
 float Avion::getVitesse() const {
-    std::lock_guard<std::mutex> lock(mtx_);
     return vitesse_;
 }
 
 float Avion::getVitesseSol() const {
-    std::lock_guard<std::mutex> lock(mtx_);
     return vitesseSol_;
 }
 
 float Avion::getCarburant() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return carburant_;
+    return page_->getCarburant(rang_);
 }
 
 float Avion::getConsommation() const {
-    std::lock_guard<std::mutex> lock(mtx_);
     return conso_;
 }
 
 Position Avion::getPosition() const {
+    return page_->position(rang_);
+}
+
+bool Avion::lireBranche(Position& position, Position& cible) const {
     std::lock_guard<std::mutex> lock(mtx_);
-    return pos_;
+    position = page_->position(rang_);
+    const Position* point = pointCourant();
+    if (!point) return false;
+    cible = *point;
+    return true;
 }
 
 EtatAvion Avion::getEtat() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return etat_;
+    return page_->getEtat(rang_);
 }
 
 Parking* Avion::getParking() const {
@@ -46,43 +103,167 @@ Parking* Avion::getParking() const {
 }
 
 Aeroport* Avion::getDestination() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return destination_;
+    return page_->getDestination(rang_);
 }
 
 float Avion::getDureeStationnement() const {
-    std::lock_guard<std::mutex> lock(mtx_);
     return dureeStationnement_;
 }
 
 bool Avion::estEnUrgence() const {
-    std::lock_guard<std::mutex> lock(mtx_);
-    return typeUrgence_ != TypeUrgence::AUCUNE;
+    return page_->getUrgence(rang_) != TypeUrgence::AUCUNE;
 }
 
 TypeUrgence Avion::getTypeUrgence() const {
+    return page_->getUrgence(rang_);
+}
+
+CategorieAvion Avion::getCategorie() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return categorie_;
+}
+
+size_t CircuitAttente::getNbPoints() const {
+    return static_cast<size_t>(nbTours) * (360 / pasDeg);
+}
+
+Position CircuitAttente::point(size_t indice) const {
+    int angleDeg = static_cast<int>(indice % (360 / pasDeg)) * pasDeg;
+    float angleRad = angleDeg * (3.14159f / 180.0f);
+    float x = centre.getX() + rayon * std::cos(angleRad);
+    float y = centre.getY() + rayon * std::sin(angleRad);
+    return Position(x, y, altitude);
+}
+
+size_t Avion::pointsRestants() const {
+    if (enCircuitAttente_) return circuit_.getNbPoints() - indiceCircuit_;
+    return trajectoire_.size() - curseurTrajectoire_;
+}
+
+const Position* Avion::pointCourant() const {
+    if (enCircuitAttente_) {
+        return (indiceCircuit_ < circuit_.getNbPoints()) ? &pointCircuit_ : nullptr;
+    }
+    return (curseurTrajectoire_ < trajectoire_.size()) ? &trajectoire_[curseurTrajectoire_] : nullptr;
+}
+
+void Avion::passerPointSuivant() {
+    if (enCircuitAttente_) {
+        ++indiceCircuit_;
+        pointCircuit_ = circuit_.point(indiceCircuit_);
+    }
+    else {
+        ++curseurTrajectoire_;
+    }
+    publierCible();
+}
+
+void Avion::publierCible() {
+    page_->setCible(rang_, pointCourant());
+}
+
+size_t Avion::getNbPointsRestants() const {
     std::lock_guard<std::mutex> lock(mtx_);
-    return typeUrgence_;
+    return pointsRestants();
 }
 
-const std::vector<Position> Avion::getTrajectoire() const {
+bool Avion::trajectoireTerminee() const {
     std::lock_guard<std::mutex> lock(mtx_);
-    return trajectoire_;
+    return pointsRestants() == 0;
+}
+
+bool Avion::getProchainPoint(Position& point) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const Position* courant = pointCourant();
+    if (!courant) return false;
+    point = *courant;
+    return true;
+}
+
+bool Avion::estEnCircuitAttente() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return enCircuitAttente_;
+}
+
+static void copierNom(char* destination, size_t taille, const std::string& source) {
+    size_t n = std::min(taille - 1, source.size());
+    std::memcpy(destination, source.data(), n);
+    destination[n] = '\0';
+}
+
+void Avion::remplirRendu(EnregistrementRendu& rendu) const {
+    Position pos = page_->position(rang_);
+    Aeroport* destination = page_->getDestination(rang_);
+    rendu.id = id_;
+    rendu.x = static_cast<float>(pos.getX());
+    rendu.y = static_cast<float>(pos.getY());
+    rendu.altitude = static_cast<float>(pos.getAltitude());
+    rendu.carburant = page_->getCarburant(rang_);
+    rendu.vitesse = vitesse_;
+    rendu.vitesseSol = vitesseSol_;
+    rendu.etat = page_->getEtat(rang_);
+    rendu.urgence = page_->getUrgence(rang_);
+    copierNom(rendu.nom, sizeof(rendu.nom), nom_);
+    copierNom(rendu.destination, sizeof(rendu.destination), destination ? destination->nom : "N/A");
 }
 
 void Avion::setPosition(const Position& p) {
     std::lock_guard<std::mutex> lock(mtx_);
-    pos_ = p;
+    page_->setPosition(rang_, p);
+    ++version_;
 }
 
+// assign() réutilise la capacité déjà allouée du vecteur
 void Avion::setTrajectoire(const std::vector<Position>& traj) {
     std::lock_guard<std::mutex> lock(mtx_);
-    trajectoire_ = traj;
+    trajectoire_.assign(traj.begin(), traj.end());
+    curseurTrajectoire_ = 0;
+    enCircuitAttente_ = false;
+    publierCible();
+    ++version_;
+}
+
+void Avion::setTrajectoire(std::initializer_list<Position> traj) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    trajectoire_.assign(traj.begin(), traj.end());
+    curseurTrajectoire_ = 0;
+    enCircuitAttente_ = false;
+    publierCible();
+    ++version_;
+}
+
+void Avion::setCircuitAttente(const CircuitAttente& circuit) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    circuit_ = circuit;
+    indiceCircuit_ = 0;
+    pointCircuit_ = circuit_.point(0);
+    enCircuitAttente_ = true;
+    publierCible();
+    ++version_;
+}
+
+void Avion::decalerAltitude(double delta) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Position pos = page_->position(rang_);
+    page_->setPosition(rang_, Position(pos.getX(), pos.getY(), pos.getAltitude() + delta));
+    ++version_;
+    if (enCircuitAttente_) {
+        circuit_.altitude += static_cast<float>(delta);
+        pointCircuit_ = circuit_.point(indiceCircuit_);
+    }
+    else {
+        for (size_t i = curseurTrajectoire_; i < trajectoire_.size(); ++i) {
+            Position& pt = trajectoire_[i];
+            pt.setPosition(pt.getX(), pt.getY(), pt.getAltitude() + delta);
+        }
+    }
+    publierCible();
 }
 
 void Avion::setEtat(EtatAvion e) {
     std::lock_guard<std::mutex> lock(mtx_);
-    etat_ = e;
+    page_->setEtat(rang_, e);
+    ++version_;
 }
 
 void Avion::setParking(Parking* p) {
@@ -92,119 +273,198 @@ void Avion::setParking(Parking* p) {
 
 void Avion::setDestination(Aeroport* dest) {
     std::lock_guard<std::mutex> lock(mtx_);
-    destination_ = dest;
+    page_->setDestination(rang_, dest);
+    ++version_;
+}
+
+void Avion::setCategorie(CategorieAvion categorie) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    categorie_ = categorie;
 }
 
 void Avion::avancer(float dt) {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    if (trajectoire_.empty()) return;
+    if (pointsRestants() == 0) return;
 
     // Vérification carburant avant mouvement
+    float carburant = page_->getCarburant(rang_);
     float consommationRequise = conso_ * dt;
-    if (carburant_ < consommationRequise) {
-        carburant_ = 0;
-        etat_ = EtatAvion::TERMINE;
-        std::cout << "[AVION " << nom_ << "] CRASH : Panne sèche en vol ! L'avion a disparu des radars.\n";
-        Logger::getInstance().log("AVION", "CRASH", "Avion " + nom_ + " crashé par manque de carburant.");
+    if (carburant < consommationRequise) {
+        tomberEnPanneSeche(false);
         return;
     }
 
-    Position cible = trajectoire_.front();
-    float dx = cible.getX() - pos_.getX();
-    float dy = cible.getY() - pos_.getY();
-    float dz = cible.getAltitude() - pos_.getAltitude();
+    Position pos = page_->position(rang_);
+    Position cible = *pointCourant();
+    float dx = cible.getX() - pos.getX();
+    float dy = cible.getY() - pos.getY();
+    float dz = cible.getAltitude() - pos.getAltitude();
     float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
     float distance_a_parcourir = vitesse_ * dt;
 
     if (dist <= distance_a_parcourir) {
-        pos_ = cible;
-        trajectoire_.erase(trajectoire_.begin());
+        pos = cible;
+        passerPointSuivant();
     }
     else {
         float nx = dx / dist;
         float ny = dy / dist;
         float nz = dz / dist;
-        pos_.setPosition(
-            pos_.getX() + nx * distance_a_parcourir,
-            pos_.getY() + ny * distance_a_parcourir,
-            pos_.getAltitude() + nz * distance_a_parcourir
+        pos.setPosition(
+            pos.getX() + nx * distance_a_parcourir,
+            pos.getY() + ny * distance_a_parcourir,
+            pos.getAltitude() + nz * distance_a_parcourir
         );
     }
+    page_->setPosition(rang_, pos);
 
-    carburant_ -= consommationRequise;
+    carburant -= consommationRequise;
+    page_->setCarburant(rang_, carburant);
 
-    // Seuil d'urgence modifié à 1000
-    if (carburant_ < 1000 && typeUrgence_ == TypeUrgence::AUCUNE) {
-        typeUrgence_ = TypeUrgence::CARBURANT;
-        std::cout << "[AVION " << nom_ << "] MAYDAY : Urgence CARBURANT declaree (< 1000L) !\n";
-    }
+    if (carburant < SEUIL_URGENCE_CARBURANT) declarerUrgenceCarburant();
 }
 
 void Avion::avancerSol(float dt) {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    if (trajectoire_.empty()) return;
+    if (pointsRestants() == 0) return;
 
     // Vérification carburant au sol aussi (même si conso réduite)
+    float carburant = page_->getCarburant(rang_);
     float consommationSol = conso_ * 0.05f;
     float consommationRequise = consommationSol * dt;
 
-    if (carburant_ < consommationRequise) {
-        carburant_ = 0;
-        // Au sol, on peut considérer qu'il s'arrête juste, mais pour la simu "crash/terminé" est demandé
-        etat_ = EtatAvion::TERMINE;
-        std::cout << "[AVION " << nom_ << "] Panne sèche au sol ! Moteurs coupés définitivement.\n";
+    if (carburant < consommationRequise) {
+        tomberEnPanneSeche(true);
         return;
     }
 
-    Position cible = trajectoire_.front();
-    float dx = cible.getX() - pos_.getX();
-    float dy = cible.getY() - pos_.getY();
-    float dz = cible.getAltitude() - pos_.getAltitude();
+    Position pos = page_->position(rang_);
+    Position cible = *pointCourant();
+    float dx = cible.getX() - pos.getX();
+    float dy = cible.getY() - pos.getY();
+    float dz = cible.getAltitude() - pos.getAltitude();
     float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
     float distance_a_parcourir = vitesseSol_ * dt;
 
     if (dist <= distance_a_parcourir) {
-        pos_ = cible;
-        trajectoire_.erase(trajectoire_.begin());
-
-        if (trajectoire_.empty()) {
-            if (etat_ == EtatAvion::ROULE_VERS_PISTE) {
-                etat_ = EtatAvion::EN_ATTENTE_PISTE;
-
-                if (parking_) {
-                    parking_->liberer();
-                    parking_ = nullptr;
-                }
-                std::cout << "[AVION " << nom_ << "] Arrive a la piste. Etat : EN_ATTENTE_PISTE.\n";
-            }
-            else if (etat_ == EtatAvion::ROULE_VERS_PARKING) {
-                etat_ = EtatAvion::STATIONNE;
-                std::cout << "[AVION " << nom_ << "] Arrive au parking "
-                    << (parking_ ? parking_->getNom() : "")
-                    << ". Etat : STATIONNE. Fin du vol.\n";
-            }
-        }
+        page_->setPosition(rang_, cible);
+        passerPointSuivant();
+        if (pointsRestants() == 0) terminerRoulage();
     }
     else {
         float nx = dx / dist;
         float ny = dy / dist;
         float nz = dz / dist;
-        pos_.setPosition(
-            pos_.getX() + nx * distance_a_parcourir,
-            pos_.getY() + ny * distance_a_parcourir,
-            pos_.getAltitude() + nz * distance_a_parcourir
-        );
+        page_->setPosition(rang_, Position(
+            pos.getX() + nx * distance_a_parcourir,
+            pos.getY() + ny * distance_a_parcourir,
+            pos.getAltitude() + nz * distance_a_parcourir
+        ));
+    }
+
+    page_->setCarburant(rang_, carburant - consommationRequise);
+}
+
+void Avion::tomberEnPanneSeche(bool auSol) {
+    page_->setCarburant(rang_, 0);
+    page_->setEtat(rang_, EtatAvion::TERMINE);
+    if (auSol) {
+        // Au sol, on peut considérer qu'il s'arrête juste, mais pour la simu "crash/terminé" est demandé
+        std::cout << "[AVION " << nom_ << "] Panne sèche au sol ! Moteurs coupés définitivement.\n";
+    }
+    else {
+        std::cout << "[AVION " << nom_ << "] CRASH : Panne sèche en vol ! L'avion a disparu des radars.\n";
+        Logger::getInstance().evenement(ActeurLog::AVION, ActionLog::CRASH, id_);
+    }
+}
+
+void Avion::terminerRoulage() {
+    EtatAvion etat = page_->getEtat(rang_);
+    if (etat == EtatAvion::ROULE_VERS_PISTE) {
+        page_->setEtat(rang_, EtatAvion::EN_ATTENTE_PISTE);
+
+        if (parking_) {
+            parking_->liberer();
+            parking_ = nullptr;
+        }
+        std::cout << "[AVION " << nom_ << "] Arrive a la piste. Etat : EN_ATTENTE_PISTE.\n";
+    }
+    else if (etat == EtatAvion::ROULE_VERS_PARKING) {
+        page_->setEtat(rang_, EtatAvion::STATIONNE);
+        std::cout << "[AVION " << nom_ << "] Arrive au parking "
+            << (parking_ ? parking_->getNom() : "")
+            << ". Etat : STATIONNE. Fin du vol.\n";
     }
+}
+
+void Avion::declarerUrgenceCarburant() {
+    if (page_->getUrgence(rang_) == TypeUrgence::AUCUNE) {
+        page_->setUrgence(rang_, TypeUrgence::CARBURANT);
+        std::cout << "[AVION " << nom_ << "] MAYDAY : Urgence CARBURANT declaree (< 1000L) !\n";
+    }
+}
+
+void Avion::avancerGroupe(const std::vector<Avion*>& avions, const std::vector<uint8_t>& auSol, float dt, LotCinematique& lot) {
+    // Par blocs de TAILLE_BLOC_CINEMATIQUE : avions, pages et lot restent en cache du relevé à
+    // la mise à jour, et les verrous ne sont tenus que le temps d'un bloc
+    constexpr size_t TAILLE_BLOC_CINEMATIQUE = 256;
+    // Avions du bloc qui ont encore un point à atteindre, dans l'ordre du lot
+    size_t engages[TAILLE_BLOC_CINEMATIQUE];
+
+    for (size_t debut = 0; debut < avions.size(); debut += TAILLE_BLOC_CINEMATIQUE) {
+        size_t fin = std::min(avions.size(), debut + TAILLE_BLOC_CINEMATIQUE);
+        size_t nbEngages = 0;
+        lot.vider();
+
+        // Verrous tenus jusqu'à la fin du bloc : chaque avion avance d'un coup, comme avec avancer().
+        // Aucun autre thread ne tient deux verrous d'avion à la fois, l'ordre de prise est donc libre.
+        for (size_t i = debut; i < fin; ++i) {
+            Avion& avion = *avions[i];
+            avion.mtx_.lock();
+            // Point visé relu dans la page plutôt que dans la trajectoire : le relevé ne touche que
+            // l'en-tête de l'Avion et les tableaux d'EtatFlotte
+            double cx, cy, cz;
+            if (!avion.page_->getCible(avion.rang_, cx, cy, cz)) continue;
+
+            double x, y, z;
+            avion.page_->coordonnees(avion.rang_, x, y, z);
+            float longueur = (auSol[i] ? avion.vitesseSol_ : avion.vitesse_) * dt;
+            float conso = auSol[i] ? avion.conso_ * 0.05f * dt : avion.conso_ * dt;
+            lot.ajouter(x, y, z, cx, cy, cz, longueur, conso, avion.page_->getCarburant(avion.rang_),
+                auSol[i] ? -1.f : SEUIL_URGENCE_CARBURANT);
+            engages[nbEngages++] = i;
+        }
+
+        avancerLot(lot);
 
-    carburant_ -= consommationRequise;
+        for (size_t k = 0; k < nbEngages; ++k) {
+            size_t i = engages[k];
+            Avion& avion = *avions[i];
+            if (lot.panne[k]) {
+                avion.tomberEnPanneSeche(auSol[i] != 0);
+                continue;
+            }
+
+            avion.page_->setCoordonnees(avion.rang_, lot.x[k], lot.y[k], lot.z[k]);
+            if (lot.atteint[k]) {
+                avion.passerPointSuivant();
+                if (auSol[i] && avion.pointsRestants() == 0) avion.terminerRoulage();
+            }
+            avion.page_->setCarburant(avion.rang_, lot.carburant[k]);
+            if (lot.urgence[k]) avion.declarerUrgenceCarburant();
+        }
+
+        for (size_t i = debut; i < fin; ++i) avions[i]->mtx_.unlock();
+    }
 }
 
 void Avion::declarerUrgence(TypeUrgence type) {
     std::lock_guard<std::mutex> lock(mtx_);
-    if (typeUrgence_ == TypeUrgence::AUCUNE) {
-        typeUrgence_ = type;
+    if (page_->getUrgence(rang_) == TypeUrgence::AUCUNE) {
+        page_->setUrgence(rang_, type);
+        ++version_;
         std::string raison;
         switch (type) {
         case TypeUrgence::PANNE_MOTEUR: raison = "PANNE MOTEUR"; break;
@@ -213,27 +473,92 @@ void Avion::declarerUrgence(TypeUrgence type) {
         default: raison = "INCONNUE"; break;
         }
         std::cout << "[AVION " << nom_ << "] MAYDAY : Urgence " << raison << " declaree !\n";
-        std::stringstream ss;
-        ss << "Urgence déclarée : " << raison << " - Position " << pos_;
-        Logger::getInstance().log("AVION", "URGENCE", ss.str());
+        Position pos = page_->position(rang_);
+        Logger::getInstance().evenement(ActeurLog::AVION, ActionLog::URGENCE, id_, static_cast<uint32_t>(type),
+            (float)pos.getX(), (float)pos.getY(), (float)pos.getAltitude());
     }
 
 }
 
 void Avion::effectuerMaintenance() {
     std::lock_guard<std::mutex> lock(mtx_);
+    ++version_;
     
     // Ajout de 2500 au réservoir existant avec un plafond à 5000
-    carburant_ += 2500.0f;
-    if (carburant_ > 5000.0f) {
-        carburant_ = 5000.0f;
+    float carburant = page_->getCarburant(rang_) + 2500.0f;
+    if (carburant > 5000.0f) {
+        carburant = 5000.0f;
     }
+    page_->setCarburant(rang_, carburant);
     
-    if (typeUrgence_ != TypeUrgence::AUCUNE) {
+    if (page_->getUrgence(rang_) != TypeUrgence::AUCUNE) {
         std::cout << "[AVION " << nom_ << "] Resolution de l'urgence. Avion operationnel.\n";
-        typeUrgence_ = TypeUrgence::AUCUNE;
+        page_->setUrgence(rang_, TypeUrgence::AUCUNE);
     }
     else {
-        std::cout << "[AVION " << nom_ << "] " << nom_ << " : Ravitaillement (+2500L). Total: " << carburant_ << "L.\n";
+        std::cout << "[AVION " << nom_ << "] " << nom_ << " : Ravitaillement (+2500L). Total: " << carburant << "L.\n";
+    }
+}
+
+uint32_t Avion::getVersion() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return version_;
+}
+
+// Mêmes formules qu'avancer/avancerSol ; deux pas de marge sur chaque seuil, les derniers pas
+// avant l'événement sont joués normalement
+int Avion::pasSansEvenement(float dt, bool auSol, double altitudePlafond) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const Position* cible = pointCourant();
+    if (!cible) return 0;
+
+    float longueurPas = (auSol ? vitesseSol_ : vitesse_) * dt;
+    float consoPas = (auSol ? conso_ * 0.05f : conso_) * dt;
+    if (longueurPas <= 0.f) return 0;
+
+    Position pos = page_->position(rang_);
+    double dx = cible->getX() - pos.getX();
+    double dy = cible->getY() - pos.getY();
+    double dz = cible->getAltitude() - pos.getAltitude();
+    double dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    // Point atteint dès qu'il reste moins d'un pas à parcourir
+    double nbPas = std::floor(dist / longueurPas) - 2;
+
+    // Panne sèche, et en vol le seuil d'urgence carburant
+    double reserve = (auSol || page_->getUrgence(rang_) != TypeUrgence::AUCUNE) ? 0.0 : SEUIL_URGENCE_CARBURANT;
+    if (consoPas > 0.f) nbPas = std::min(nbPas, std::floor((page_->getCarburant(rang_) - reserve) / consoPas) - 2);
+
+    double montee = (dist > 0.0) ? dz / dist * longueurPas : 0.0;
+    if (montee > 0.0) nbPas = std::min(nbPas, std::floor((altitudePlafond - pos.getAltitude()) / montee) - 2);
+
+    return (nbPas > 0.0) ? static_cast<int>(std::min(nbPas, 1e9)) : 0;
+}
+
+void Avion::avancerPas(int nbPas, float dt, bool auSol) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    const Position* cible = pointCourant();
+    if (!cible || nbPas <= 0) return;
+
+    float distance_a_parcourir = (auSol ? vitesseSol_ : vitesse_) * dt;
+    float consommationRequise = (auSol ? conso_ * 0.05f : conso_) * dt;
+
+    // Pas rejoués un à un avec les calculs d'avancer()/avancerSol() : un seul déplacement de
+    // nbPas pas n'arrondit pas pareil, et l'avion franchirait ses seuils un pas plus tôt ou plus tard
+    Position pos = page_->position(rang_);
+    float carburant = page_->getCarburant(rang_);
+    for (int pas = 0; pas < nbPas; ++pas) {
+        float dx = cible->getX() - pos.getX();
+        float dy = cible->getY() - pos.getY();
+        float dz = cible->getAltitude() - pos.getAltitude();
+        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        pos.setPosition(
+            pos.getX() + dx / dist * distance_a_parcourir,
+            pos.getY() + dy / dist * distance_a_parcourir,
+            pos.getAltitude() + dz / dist * distance_a_parcourir
+        );
+        carburant -= consommationRequise;
     }
+    page_->setPosition(rang_, pos);
+    page_->setCarburant(rang_, carburant);
 }
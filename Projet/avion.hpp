@@ -8,22 +8,107 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <map>
+#include "journal.hpp"
+#include "horloge.hpp"
+
+// SYNCHRONE : l'appelant formate et écrit lui-même dans le fichier (sous verrou).
+// ASYNCHRONE : l'appelant dépose un enregistrement de taille fixe dans un anneau sans verrou,
+//              un thread dédié le sérialise et l'écrit.
+enum class ModeLogger {
+    SYNCHRONE,
+    ASYNCHRONE
+};
+
+// Comportement d'un producteur quand l'anneau est plein (mode ASYNCHRONE)
+enum class PolitiqueSaturation {
+    BLOQUER,    // attend qu'une case se libère
+    ABANDONNER  // jette l'enregistrement et incrémente le compteur d'abandons
+};
 
 class Logger {
 private:
+    struct CelluleLog {
+        std::atomic<size_t> sequence;
+        EvenementJournal donnees;
+    };
+
     std::ofstream fichier_;
     std::mutex mutex_;
     bool premierElement_;
+    bool ouvert_;
+    FormatJournal format_;
+
+    // Noms des avions et symboles ; les définitions sont écrites dans le fichier binaire
+    // juste avant le premier événement qui les utilise. Le nom d'un avion (et sa définition)
+    // est oublié quand le registre le recycle : les tables restent à la taille de la flotte.
+    std::mutex mutexNoms_;
+    TableNoms noms_;
+    std::unordered_set<uint32_t> avionsDefinis_;
+    std::vector<std::unordered_set<uint32_t>::node_type> definisLibres_;   // repris comme TableNoms
+    std::unordered_set<uint32_t> symbolesDefinis_;
+
+    std::atomic<ModeLogger> mode_;
+    PolitiqueSaturation politique_;
+    std::unique_ptr<CelluleLog[]> anneau_;
+    size_t masque_;
+    // Fermeture du mode asynchrone : ce bit posé dans posEcriture_ fait échouer tout dépôt
+    // suivant, sans compteur de producteurs à tenir à chaque événement. Les dépôts déjà
+    // réservés sont attendus par la dernière vidange, avant le retour au mode synchrone.
+    static constexpr size_t DEPOT_FERME = ~(~size_t(0) >> 1);
+    std::atomic<size_t> posEcriture_;
+    size_t posLecture_;
+    std::atomic<unsigned int> signal_;
+    // L'écrivain ne dort qu'anneau vide, après avoir levé ce drapeau : seul le premier
+    // producteur qui le voit levé le baisse et le réveille
+    std::atomic<bool> ecrivainEnAttente_;
+    std::atomic<bool> ecrivainActif_;
+    std::atomic<unsigned long long> nbAbandonnes_;
+    std::thread ecrivain_;
 
     Logger();
     ~Logger();
 
+    void ouvrir();
+    void ecrire(const EvenementJournal& evenement);
+    void ecrireDefinition(ActionLog type, uint32_t id, const std::string& nom);
+    // Vrai si l'avion n'était pas encore défini dans le fichier (il l'est désormais)
+    bool marquerAvionDefini(uint32_t id);
+    // Mode asynchrone : dépôt dans l'anneau (sauf abandon si abandonnable), sinon écriture directe
+    void transmettre(const EvenementJournal& evenement, bool abandonnable);
+    enum class ResultatDepot { DEPOSE, PLEIN, FERME };
+    ResultatDepot deposer(const EvenementJournal& evenement);
+    bool retirer(EvenementJournal& evenement);
+    // Vrai si aucun dépôt réservé ne reste à retirer
+    bool anneauVide() const;
+    void boucleEcrivain();
+    void arreterEcrivain();
+
 public:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
     static Logger& getInstance();
-    void log(const std::string& acteur, const std::string& action, const std::string& details);
+
+    // À appeler avant de lancer les routines ; capacite est arrondie à la puissance de 2 supérieure
+    void configurer(ModeLogger mode, PolitiqueSaturation politique = PolitiqueSaturation::BLOQUER, size_t capacite = 8192);
+    // À appeler avant le premier événement (choisit img/logs.json ou img/logs.bin)
+    void setFormat(FormatJournal format);
+    ModeLogger getMode() const;
+    unsigned long long getNbAbandonnes() const;
+
+    void nommerAvion(uint32_t id, const std::string& nom);
+    // Le nom de l'avion ne sert plus : oublié une fois écrits les événements déjà transmis
+    void oublierAvion(uint32_t id);
+    uint32_t symbole(const std::string& texte);
+
+    // Voir EvenementJournal pour la signification de reference et des valeurs selon l'action
+    void evenement(ActeurLog acteur, ActionLog action, uint32_t idAvion,
+        uint32_t reference = 0, float v0 = 0.f, float v1 = 0.f, float v2 = 0.f);
 };
 
 
@@ -32,6 +117,15 @@ class Parking;
 class TWR;
 class APP;
 class CCR;
+class IndexSpatial;
+struct LotRapprochements;
+class AllocateurParkings;
+class FileDecollage;
+class Piste;
+class GestionnaireArrivees;
+class PoolTravailleurs;
+struct PageFlotte;
+struct EnregistrementRendu;
 struct Aeroport;
 
 class Position {
@@ -68,97 +162,262 @@ enum class TypeUrgence {
     MEDICAL
 };
 
+// Gabarit d'un avion, et plus gros gabarit accepté par un parking
+enum class CategorieAvion {
+    LEGER,
+    MOYEN,
+    LOURD
+};
+
+// Choix du parking attribué à un avion qui atterrit (voir AllocateurParkings)
+enum class PolitiqueParking {
+    PLUS_PROCHE_PISTE,  // le plus proche de la piste parmi ceux qui acceptent l'avion
+    TAILLE_AJUSTEE      // le plus petit gabarit suffisant, puis le plus proche de la piste
+};
+
+// L'occupation d'un parking est tenue par l'allocateur de sa TWR (voir TWR::reserverParking) ;
+// un parking qui n'appartient à aucune TWR est toujours libre.
 class Parking {
 private:
+    friend class AllocateurParkings;
+
     std::string nom_;
-    bool occupe_;
     Position pos_;
+    CategorieAvion gabarit_;
+    AllocateurParkings* allocateur_;
+    uint32_t rang_;
 public:
-    Parking(const std::string& nom, Position pos);
+    Parking(const std::string& nom, Position pos, CategorieAvion gabarit = CategorieAvion::LOURD);
     const std::string& getNom() const;
     double getDistancePiste(const Position& posPiste) const;
     const Position& getPosition() const;
+    CategorieAvion getGabarit() const;
     bool estOccupe() const;
-    void occuper();
+    // Rend le parking à l'allocateur (appelé par l'avion qui le quitte)
     void liberer();
 };
 
-class Avion {
+// Circuit d'attente paramétrique : les points (tous les pasDeg degrés sur nbTours tours)
+// sont calculés à la demande au lieu d'être stockés
+struct CircuitAttente {
+    Position centre;
+    float rayon;
+    float altitude;
+    int nbTours;
+    int pasDeg = 10;
+
+    size_t getNbPoints() const;
+    Position point(size_t indice) const;
+};
+
+// En vol, carburant (L) sous lequel l'avion déclare une urgence CARBURANT
+constexpr float SEUIL_URGENCE_CARBURANT = 1000.f;
+
+struct LotCinematique;
+
+class alignas(64) Avion {
 private:
-    std::string nom_;
+    // En tête, sur une même ligne de cache : tout ce que lit un pas groupé (avancerGroupe)
+    uint32_t id_;
     float vitesse_;
     float vitesseSol_;
-    float carburant_;
     float conso_;
-    Position pos_;
+    // Position, état, carburant, urgence, destination et point visé : emplacement_ dans EtatFlotte
+    // (rang_ de page_), pris à la construction et rendu à la destruction ; écrit sous mtx_ et lu sans verrou
+    uint32_t emplacement_;
+    uint32_t rang_;
+    PageFlotte* page_;
+    mutable std::mutex mtx_;
+    std::string nom_;
     std::vector<Position> trajectoire_;
-    EtatAvion etat_;
+    size_t curseurTrajectoire_;  // prochain point à atteindre dans trajectoire_
+    bool enCircuitAttente_;      // si vrai, la trajectoire suivie est circuit_ et non trajectoire_
+    CircuitAttente circuit_;
+    size_t indiceCircuit_;
+    Position pointCircuit_;      // point courant du circuit, recalculé à chaque point atteint
     float dureeStationnement_;
     Parking* parking_;
-    Aeroport* destination_;
-    TypeUrgence typeUrgence_;
-    mutable std::mutex mtx_;
+    CategorieAvion categorie_;
+    uint32_t version_;           // incrémentée par toute modification venue d'un contrôleur ou du pilote
+
+    // Accès à la trajectoire suivie (liste de points ou circuit), appelés sous mtx_
+    size_t pointsRestants() const;
+    const Position* pointCourant() const;
+    void passerPointSuivant();
+    // Recopie pointCourant() dans la page, après tout changement de trajectoire ou de point
+    void publierCible();
+    // État de départ d'un vol dans la page, et nom annoncé au journal
+    void initialiserVol(const Position& pos, float carburant);
+    // Issues d'un pas de physique (avancer, avancerSol, avancerGroupe), appelées sous mtx_
+    void tomberEnPanneSeche(bool auSol);
+    void terminerRoulage();
+    void declarerUrgenceCarburant();
 
 public:
     Avion(std::string n, float v, float vSol, float c, float conso, float dureeStat, Position pos);
+    ~Avion();
+    // Réarme un avion recyclé pour un nouveau vol, comme s'il venait d'être construit avec ces
+    // paramètres (nouvel identifiant) ; garde son emplacement dans EtatFlotte et la mémoire de sa
+    // trajectoire. Personne d'autre ne doit plus le désigner (voir RegistreAvions).
+    void reprendre(const std::string& n, float v, float vSol, float c, float conso, float dureeStat, const Position& pos);
 
+    // Identifiant de vol, jamais réutilisé (journal) ; emplacement dans EtatFlotte, repris après destruction
+    uint32_t getId() const;
+    uint32_t getEmplacement() const;
     std::string getNom() const;
     float getVitesse() const;
     float getVitesseSol() const;
     float getCarburant() const;
     float getConsommation() const;
     Position getPosition() const;
-    const std::vector<Position> getTrajectoire() const;
+    // Position et point visé par la branche en cours, relevés ensemble ; false s'il n'y en a plus
+    bool lireBranche(Position& position, Position& cible) const;
+    // Requêtes sur la trajectoire restante, sans copie
+    size_t getNbPointsRestants() const;
+    bool trajectoireTerminee() const;
+    bool getProchainPoint(Position& point) const;
     EtatAvion getEtat() const;
     Parking* getParking() const;
     Aeroport* getDestination() const;
     float getDureeStationnement() const;
     bool estEnUrgence() const;
     TypeUrgence getTypeUrgence() const;
+    CategorieAvion getCategorie() const;
+
+    bool estEnCircuitAttente() const;
+    // Relève tout ce qu'affiche le visualiseur sous une seule prise du verrou
+    void remplirRendu(EnregistrementRendu& rendu) const;
 
     void setPosition(const Position& p);
     void setTrajectoire(const std::vector<Position>& traj);
+    void setTrajectoire(std::initializer_list<Position> traj);
+    void setCircuitAttente(const CircuitAttente& circuit);
+    // Décale l'altitude de l'avion et de tous ses points restants, en place
+    void decalerAltitude(double delta);
     void setEtat(EtatAvion e);
     void setParking(Parking* p);
     void setDestination(Aeroport* dest);
+    void setCategorie(CategorieAvion categorie);
 
     void declarerUrgence(TypeUrgence type);
     void avancer(float dt);
     void avancerSol(float dt);
     void effectuerMaintenance();
+
+    // Moteur à événements : nombre de pas de pur mouvement à venir (ni point atteint, ni seuil
+    // de carburant, ni altitude plafond franchie), puis avance de nbPas pas d'un coup, au même
+    // arrondi près que nbPas appels à avancer/avancerSol
+    uint32_t getVersion() const;
+    int pasSansEvenement(float dt, bool auSol, double altitudePlafond) const;
+    void avancerPas(int nbPas, float dt, bool auSol);
+
+    // Un pas de physique pour tout un groupe : même effet qu'avancer (auSol[i] nul) ou avancerSol
+    // sur chaque avion, déplacements et consommations calculés ensemble par avancerLot. lot sert
+    // de tampon d'un appel à l'autre.
+    static void avancerGroupe(const std::vector<Avion*>& avions, const std::vector<uint8_t>& auSol,
+        float dt, LotCinematique& lot);
     friend std::ostream& operator<<(std::ostream& os, const Avion& avion);
 };
 
+// Compteurs de la file de décollage d'une TWR ; attente = de l'enregistrement à l'autorisation
+struct StatistiquesDecollage {
+    size_t profondeur;
+    size_t profondeurMax;
+    unsigned long long nbDecollages;
+    double attenteMoyenneMs;
+    long long attenteMaxMs;
+    std::vector<unsigned long long> decollagesParPiste;
+};
+
+// Créneau d'atterrissage réservé par l'APP pour un avion en approche
+struct CreneauArrivee {
+    size_t piste;
+    long long debutMs;
+};
+
+// Compteurs du séquencement des arrivées d'une APP ; retard = créneau - heure d'arrivée au plus tôt
+struct StatistiquesArrivee {
+    unsigned long long nbSequencees;
+    unsigned long long nbRetardees;
+    unsigned long long nbCreneauxRendus;   // retard trop long à absorber : créneau rendu à la planification
+    double retardMoyenMs;          // sur les arrivées retardées
+    long long retardMaxMs;
+    unsigned long long nbRefus;
+    unsigned long long nbMisesEnAttente;
+};
+
 class TWR {
 private:
-    float tempsAtterrissageDecollage_;
-    bool pisteLibre_;
-    Position posPiste_;
+    float tempsAtterrissageDecollage_;   // durée d'occupation de piste d'un mouvement (ms simulées)
+    Position posPiste_;                  // piste principale : repère de l'approche et des parkings
+    std::vector<Piste> pistes_;
+    std::unordered_map<const Avion*, size_t> pisteAssignee_;
+    std::unordered_map<const Avion*, CreneauArrivee> creneauxArrivee_;
     std::vector<Parking> parkings_;
-    std::vector<Avion*> filePourDecollage_;
+    std::unique_ptr<AllocateurParkings> allocateur_;
+    std::unique_ptr<FileDecollage> fileDecollage_;
+    size_t profondeurMaxDecollage_;
+    unsigned long long nbDecollages_;
+    std::vector<unsigned long long> decollagesParPiste_;
+    long long attenteCumuleeMs_;
+    long long attenteMaxMs_;
     bool urgenceEnCours_;
     mutable std::mutex mutexTWR_;
+    // Réveille routine_twr, et l'APP abonnée, quand la piste, un parking ou la file change
+    SignalHorloge signal_;
+    std::vector<SignalHorloge*> abonnes_;
+
+    int choisirPisteLibre(long long tMs);
+    int choisirPisteDepart(const Position& parking) const;
+    size_t choisirPisteProchaine(long long tMs) const;
 
 public:
+    // Piste i en positionsPistes[i] ; la première est la piste principale
+    TWR(const std::vector<Parking>& parkings, const std::vector<Position>& positionsPistes, float tempsAtterrisageDecollage);
     TWR(const std::vector<Parking>& parkings, Position posPiste, float tempsAtterrisageDecollage);
+    ~TWR();
 
     Position getPositionPiste() const;
+    // Seuil de la piste attribuée à l'avion (atterrissage ou décollage), sinon piste principale
+    Position getPositionPiste(const Avion* avion) const;
+    size_t getNombrePistes() const;
     bool estPisteLibre() const;
-    void libererPiste();
-    void reserverPiste();
+    // L'avion a dégagé sa piste (fin d'atterrissage ou évacuation)
+    void libererPiste(const Avion* avion);
+    // Délai avant la fin du prochain créneau de piste, borné par delaiMaxMs : une piste peut
+    // redevenir libre sans qu'aucun avion ne bouge
+    long long delaiReveil(long long delaiMaxMs) const;
 
+    // Réserve pour l'avion le premier créneau d'atterrissage à partir de etaMs, toutes pistes
+    // confondues (remplace sa réservation précédente)
+    CreneauArrivee reserverCreneauArrivee(const Avion* avion, long long etaMs);
+    void annulerCreneauArrivee(const Avion* avion);
+    // Un avion qui se présente pendant son créneau se pose dessus ; sinon, première piste libre
     bool autoriserAtterrissage(Avion* avion);
-    Parking* choisirParkingLibre();
+    // Réserve un parking libre adapté à l'avion selon la politique de la TWR (nullptr si aucun) ;
+    // sans verrou, peut être appelé depuis n'importe quel pilote
+    Parking* reserverParking(const Avion* avion);
+    void setPolitiqueParking(PolitiqueParking politique);
+    size_t getNombreParkingsLibres() const;
     void attribuerParking(Avion* avion, Parking* parking);
     void gererRoulageVersParking(Avion* avion, Parking* p);
 
     void enregistrerPourDecollage(Avion* avion);
     bool autoriserDecollage(Avion* avion);
-    Avion* choisirAvionPourDecollage() const;
+    // Fait rouler les avions au parking vers les pistes sans départ, puis ajoute à prets les
+    // avions au seuil d'une piste libre (un par piste)
+    void choisirAvionsPourDecollage(std::vector<Avion*>& prets);
     void retirerAvionDeDecollage(Avion* avion);
+    StatistiquesDecollage getStatistiquesDecollage() const;
+    // Avion terminé sur le point d'être détruit : retiré de la file, des pistes et des créneaux
+    void oublier(const Avion* avion);
 
     void setUrgenceEnCours(bool statut);
     bool estUrgenceEnCours() const;
+
+    SignalHorloge& getSignal();
+    void abonner(SignalHorloge* signal);
+    void signaler();
 };
 
 class APP {
@@ -166,10 +425,21 @@ private:
     std::vector<Avion*> avionsDansZone_;
     std::queue<Avion*> fileAttenteAtterrissage_;
     TWR* twr_;
-    std::recursive_mutex mutexAPP_;
+    std::unique_ptr<GestionnaireArrivees> arrivees_;
+    std::vector<Position> trajectoire_;  // tampon des approches planifiées, réutilisé d'un vol à l'autre
+    unsigned long long nbRefus_;
+    unsigned long long nbMisesEnAttente_;
+    const Avion* avionUrgence_;          // dernier avion dirigé en urgence vers la piste
+    mutable std::recursive_mutex mutexAPP_;
+    // Réveille routine_app : entrée dans la zone, mise en attente, urgence, piste ou parking libéré
+    SignalHorloge signal_;
+
+    // L'avion en urgence ne se posera plus : la TWR reprend son trafic
+    void abandonnerUrgence();
 
 public:
     APP(TWR* tour);
+    ~APP();
 
     void ajouterAvion(Avion* avion);
     void assignerTrajectoireApproche(Avion* avion);
@@ -177,22 +447,119 @@ public:
     bool demanderAutorisationAtterrissage(Avion* avion);
     void mettreAJour();
     void gererUrgence(Avion* avion);
+    // Avion terminé sur le point d'être détruit : retiré de la zone, de la file et de l'urgence
+    void oublier(const Avion* avion);
     size_t getNombreAvionsDansZone() const;
+    StatistiquesArrivee getStatistiquesArrivee() const;
+
+    SignalHorloge& getSignal();
+    void signaler();
+    // Les créneaux de piste de la TWR peuvent débloquer un atterrissage sans signal
+    long long delaiReveil(long long delaiMaxMs) const;
 };
 
 class CCR {
 private:
-    std::vector<Avion*> avionsEnCroisiere_;
-    std::mutex mutexCCR_;
+    // Mode prédictif : branche en cours d'un avion
+    struct Branche {
+        double vx, vy, vz;      // par pas
+        double pasRestants;     // avant la fin de la branche
+    };
+
+    // Avions traités ensemble par une passe : ceux d'un secteur, ou ceux des bandes frontières
+    // (origines donne alors le secteur de chaque avion : seules les paires à cheval sont testées).
+    // Positions relevées une fois par passe, grilles de détection et résultats propres à la zone.
+    struct Zone {
+        std::vector<Avion*> avions;
+        std::vector<uint32_t> emplacements;
+        std::vector<Position> positions;
+        std::vector<Branche> branches;
+        std::vector<size_t> origines;
+        std::vector<std::pair<size_t, size_t>> conflits;
+        std::unique_ptr<IndexSpatial> index;
+        // Grille dont les cellules couvrent le rapprochement possible sur l'horizon
+        std::unique_ptr<IndexSpatial> indexPrediction;
+        double tailleCellulePrediction = 0.0;
+        double hauteurCellulePrediction = 0.0;
+        std::unique_ptr<LotRapprochements> lot;
+        double pasMax = 0.0;    // plus grand déplacement horizontal par pas relevé
+        unsigned long long nbResolutions = 0;
+        // Messages console de la passe : les secteurs traités en parallèle ne se mélangent pas,
+        // gererEspaceAerien les écrit ensuite dans l'ordre des secteurs
+        std::ostringstream console;
+
+        Zone();
+        ~Zone();
+    };
+
+    // Secteurs carrés de tailleSecteur_ (0 : un seul secteur pour tout l'espace aérien),
+    // par indices de cellule ; parcourus dans l'ordre des clés pour rester reproductible
+    std::map<std::pair<int64_t, int64_t>, std::unique_ptr<Zone>> secteurs_;
+    Zone frontiere_;
+    double tailleSecteur_;
+    std::unique_ptr<PoolTravailleurs> pool_;
+    mutable std::mutex mutexCCR_;
+
+    double horizonPas_;     // horizon de prédiction en pas pilote (0 = réactif)
+    unsigned long long nbTransmissions_;
+    unsigned long long nbResolutionsSecteursFermes_;   // des secteurs vidés puis supprimés
+
+    // Grille grossière pour borner la distance entre les deux avions les plus proches
+    std::unique_ptr<IndexSpatial> horizon_;
+    std::vector<Position> positions_;
+    std::vector<std::pair<size_t, size_t>> paires_;
+
+    std::pair<int64_t, int64_t> cleSecteur(const Position& position) const;
+    Zone& secteur(const std::pair<int64_t, int64_t>& cle);
+    // Passe les avions sortis de leur secteur au secteur qu'ils survolent
+    void transmettreEntreSecteurs();
+    // Relève positions (et branches en mode prédictif) des avions de la zone
+    void relever(Zone& zone);
+    // Avions proches d'une limite de leur secteur, avec les positions relevées par leur secteur
+    void construireFrontiere();
+    // Détecte et résout les conflits de la zone à partir des positions relevées
+    void separer(Zone& zone);
+    void separerAvions(Zone& zone, size_t i, size_t j);
+    void detecterConflitsPrevus(Zone& zone);
+    // Écarte verticalement i et j juste assez pour qu'ils restent séparés sur [debut, fin]
+    void resoudreConflitPrevu(Zone& zone, size_t i, size_t j, double debut, double fin);
+    // Conflit de la paire k du lot sur ses branches entières, avec les altitudes courantes
+    bool conflitSurBranches(const Zone& zone, size_t k, double& debut, double& fin) const;
+    // Transferts vers l'APP (entrée dans le rayon de contrôle ou urgence) des avions du secteur
+    void transfererSortants(Zone& zone);
 
 public:
     CCR();
+    ~CCR();
 
     void prendreEnCharge(Avion* avion);
     void gererEspaceAerien();
     void transfererVersApproche(Avion* avion, APP* appCible);
+    // Avion terminé sur le point d'être détruit : retiré de son secteur
+    void oublier(const Avion* avion);
+
+    // Anticipation des conflits sur horizonMs de temps simulé, d'après la branche en cours de
+    // chaque avion (point de plus proche approche) ; 0 revient au mode réactif
+    void setHorizonPrediction(long long horizonMs);
+    unsigned long long getNbResolutions() const;
+
+    // Découpe l'espace aérien en secteurs carrés de tailleSecteur mètres (0 : un seul secteur).
+    // Chaque passe traite les secteurs en parallèle sur nbTravailleurs threads en plus du sien,
+    // puis les paires à cheval sur une limite, entre avions proches des limites de leur secteur.
+    void configurerSecteurs(double tailleSecteur, int nbTravailleurs);
+    size_t getNbSecteurs() const;
+    unsigned long long getNbTransmissions() const;
+
+    // Moteur à événements : nombre de pas pilote (de durée dt) pendant lesquels une passe ne
+    // peut rien faire (ni conflit, ni transfert, ni urgence), d'après les positions actuelles.
+    // Les nouvelles prises en charge et les urgences ne sont pas prévues : l'appelant s'en charge.
+    int pasSansIntervention(float dt);
 };
 
+constexpr double ESPACEMENT_PISTES = 1500.0;
+// Créneau réservé par mouvement, en temps simulé
+constexpr float DUREE_OCCUPATION_PISTE_MS = 5000.f;
+
 struct Aeroport {
     std::string nom;
     Position position;
@@ -200,6 +567,13 @@ struct Aeroport {
     TWR* twr;
     APP* app;
     std::vector<Parking> parkings;
+    CategorieAvion gabaritMax;      // plus gros gabarit accepté par l'un des parkings
+
+    // Pistes parallèles espacées de ESPACEMENT_PISTES, la première à la position de l'aéroport ;
+    // cinq parkings G1 à G5, ou ceux fournis (déjà nommés et placés)
+    Aeroport(std::string n, Position pos, float rayon = 100000.0f, int nbPistes = 1);
+    Aeroport(std::string n, Position pos, float rayon, int nbPistes, std::vector<Parking> listeParkings);
 
-    Aeroport(std::string n, Position pos, float rayon = 100000.0f);
+    // Un parking au moins peut recevoir un avion de cette catégorie
+    bool accepte(CategorieAvion categorie) const;
 };
@@ -0,0 +1,554 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+#include "avion.hpp"
+#include "indexspatial.hpp"
+#include "etatflotte.hpp"
+#include "cinematique.hpp"
+#include "thread.hpp"
+#include "registreavions.hpp"
+#include "gestionnairearrivees.hpp"
+#include "descriptionscenario.hpp"
+#include "scenario.hpp"
+
+// Banc de mesure des chemins chauds de la simulation, chacun isolé du reste.
+// Usage : bench [--json fichier]
+// La table lisible va sur la sortie standard ; --json écrit en plus les résultats dans
+// un format stable (un objet par mesure) pour comparer deux versions.
+
+// Compteur d'allocations du programme entier : remplace les opérateurs new/delete de base et leurs
+// versions alignées, celles des types sur-alignés comme Avion (les versions tableau et nothrow y aboutissent)
+static std::atomic<unsigned long long> nbAllocations{ 0 };
+
+void* operator new(std::size_t taille) {
+    nbAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(taille ? taille : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void* operator new(std::size_t taille, std::align_val_t alignement) {
+    nbAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = static_cast<std::size_t>(alignement);
+#ifdef _MSC_VER
+    if (void* p = _aligned_malloc(taille ? taille : 1, a)) return p;
+#else
+    // aligned_alloc veut une taille multiple de l'alignement
+    if (void* p = std::aligned_alloc(a, ((taille ? taille : 1) + a - 1) / a * a)) return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignement) noexcept {
+    operator delete(p, alignement);
+}
+
+struct Resultat {
+    std::string cas;
+    size_t taille;          // nombre d'avions, longueur de file ou nombre de producteurs
+    int iterations;
+    double usParOperation;  // durée moyenne d'une opération en microsecondes
+};
+
+static std::vector<Resultat> resultats;
+
+static void rapporter(const std::string& cas, size_t taille, int iterations, double usParOperation) {
+    resultats.push_back({ cas, taille, iterations, usParOperation });
+    std::cout << std::left << std::setw(34) << cas << std::right << std::setw(8) << taille
+        << std::setw(14) << std::fixed << std::setprecision(3) << usParOperation
+        << std::setw(16) << std::setprecision(0) << (1e6 / usParOperation) << "\n";
+}
+
+static bool ecrireJSON(const std::string& chemin) {
+    std::ofstream sortie(chemin);
+    if (!sortie.is_open()) return false;
+
+    sortie << std::fixed << "[\n";
+    for (size_t i = 0; i < resultats.size(); ++i) {
+        const Resultat& r = resultats[i];
+        sortie << "  {\"cas\": \"" << r.cas << "\", \"taille\": " << r.taille
+            << ", \"iterations\": " << r.iterations
+            << ", \"us_par_operation\": " << std::setprecision(4) << r.usParOperation
+            << ", \"operations_par_s\": " << std::setprecision(1) << (1e6 / r.usParOperation) << "}"
+            << (i + 1 < resultats.size() ? ",\n" : "\n");
+    }
+    sortie << "]\n";
+    return true;
+}
+
+// Coupe les messages console des contrôleurs pendant une mesure (ils domineraient le temps),
+// ou les détourne vers destination pour les comparer
+class SilenceConsole {
+private:
+    std::streambuf* ancien_;
+public:
+    explicit SilenceConsole(std::streambuf* destination = nullptr) : ancien_(std::cout.rdbuf(destination)) {}
+    ~SilenceConsole() { std::cout.rdbuf(ancien_); }
+};
+
+// Positions de croisière aléatoires sur un carré de la taille de la France
+static std::vector<Position> genererPositions(size_t n, unsigned int graine) {
+    std::mt19937 gen(graine);
+    std::uniform_real_distribution<double> horizontal(-800000.0, 800000.0);
+    std::uniform_real_distribution<double> vertical(9000.0, 11000.0);
+
+    std::vector<Position> positions;
+    positions.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        positions.emplace_back(horizontal(gen), horizontal(gen), vertical(gen));
+    }
+    return positions;
+}
+
+static std::vector<std::unique_ptr<Avion>> genererAvions(size_t n, const std::vector<Position>& positions) {
+    std::vector<std::unique_ptr<Avion>> avions;
+    avions.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        avions.push_back(std::make_unique<Avion>("BN-" + std::to_string(i), 4000.f, 5.f, 1e9f, 10.f, 5000.f, positions[i]));
+    }
+    return avions;
+}
+
+// Durée moyenne d'un appel en microsecondes
+template <typename Fonction>
+static double mesurer(int iterations, Fonction&& f) {
+    auto debut = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) f();
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(fin - debut).count() / iterations;
+}
+
+static int iterationsPour(size_t n) {
+    return (n >= 10000) ? 3 : (n >= 1000 ? 20 : 1000);
+}
+
+// Détection seule : force brute contre grille, avec vérification que les paires sont identiques
+static bool benchDetection() {
+    for (size_t n : { 10, 100, 1000, 10000 }) {
+        std::vector<Position> positions = genererPositions(n, 42);
+        std::vector<PaireConflit> conflitsBrute, conflitsIndex;
+        IndexSpatial index;
+        int iterations = iterationsPour(n);
+
+        double tBrute = mesurer(iterations, [&] { detecterConflitsForceBrute(positions, conflitsBrute); });
+        double tIndex = mesurer(iterations, [&] {
+            index.construire(positions);
+            index.detecterConflits(positions, conflitsIndex);
+        });
+
+        if (conflitsBrute != conflitsIndex) {
+            std::cerr << "[BENCH] Resultats differents pour " << n << " avions !\n";
+            return false;
+        }
+        rapporter("detection.force_brute", n, iterations, tBrute);
+        rapporter("detection.index_spatial", n, iterations, tIndex);
+    }
+    return true;
+}
+
+// Passe complète de la CCR (relevé des positions, séparation, recherche des transferts)
+static void benchCCR() {
+    // Destination hors de portée : aucun avion n'est transféré pendant la mesure
+    Aeroport lointain("Lointain", Position(5e7, 5e7, 0));
+
+    // Détection réactive, anticipée sur une seconde de vol, puis réactive par secteurs de
+    // 200 km traités par 4 threads
+    struct Configuration {
+        const char* cas;
+        long long horizonMs;
+        double tailleSecteur;
+        int nbTravailleurs;
+    };
+    for (const Configuration& configuration : {
+            Configuration{ "ccr.gererEspaceAerien", 0, 0.0, 0 },
+            Configuration{ "ccr.gererEspaceAerien.prediction", 1000, 0.0, 0 },
+            Configuration{ "ccr.gererEspaceAerien.secteurs", 0, 200000.0, 3 } }) {
+        for (size_t n : { 10, 100, 1000, 10000 }) {
+            std::vector<Position> positions = genererPositions(n, 42);
+            std::vector<std::unique_ptr<Avion>> avions = genererAvions(n, positions);
+            CCR ccr;
+            ccr.setHorizonPrediction(configuration.horizonMs);
+            ccr.configurerSecteurs(configuration.tailleSecteur, configuration.nbTravailleurs);
+            int iterations = iterationsPour(n);
+            double t;
+            {
+                SilenceConsole silence;
+                for (size_t i = 0; i < n; ++i) {
+                    avions[i]->setDestination(&lointain);
+                    ccr.prendreEnCharge(avions[i].get());
+                    avions[i]->setPosition(positions[i]);
+                }
+                t = mesurer(iterations, [&] { ccr.gererEspaceAerien(); });
+            }
+            rapporter(configuration.cas, n, iterations, t);
+        }
+    }
+}
+
+// Coût d'un pas d'avancement en vol, par avion : avancer() avion par avion, puis le même vol
+// sur une copie de la flotte en pas groupés, dont les positions doivent rester celles du premier
+static bool benchAvancer() {
+    const size_t n = 10000;
+    const int ticks = 100;
+    const double tolerance = 1e-3;
+    std::vector<Position> positions = genererPositions(n, 7);
+    // Cibles tirées sur tout le carré : une partie des avions les atteint pendant la mesure
+    std::vector<Position> cibles = genererPositions(n, 8);
+    std::vector<std::unique_ptr<Avion>> avions = genererAvions(n, positions);
+    std::vector<std::unique_ptr<Avion>> copies = genererAvions(n, positions);
+    std::vector<Avion*> groupe;
+    for (size_t i = 0; i < n; ++i) {
+        for (Avion* avion : { avions[i].get(), copies[i].get() }) {
+            avion->setTrajectoire({ cibles[i] });
+            avion->setEtat(EtatAvion::EN_ROUTE);
+        }
+        groupe.push_back(copies[i].get());
+    }
+
+    double t = mesurer(ticks, [&] {
+        for (auto& avion : avions) avion->avancer(DT_PILOTE);
+    });
+    rapporter("avion.avancer", n, ticks * static_cast<int>(n), t / n);
+
+    std::vector<uint8_t> auSol(n, 0);
+    LotCinematique lot;
+    t = mesurer(ticks, [&] { Avion::avancerGroupe(groupe, auSol, DT_PILOTE, lot); });
+    rapporter("avion.avancerGroupe", n, ticks * static_cast<int>(n), t / n);
+
+    for (size_t i = 0; i < n; ++i) {
+        Position attendue = avions[i]->getPosition();
+        Position obtenue = copies[i]->getPosition();
+        if (attendue.distance(obtenue) > tolerance
+            || avions[i]->getNbPointsRestants() != copies[i]->getNbPointsRestants()
+            || avions[i]->getCarburant() != copies[i]->getCarburant()) {
+            std::cerr << "[BENCH] Pas groupe different du pas avion par avion pour " << avions[i]->getNom() << " !\n";
+            return false;
+        }
+    }
+
+    // Noyau seul, sans verrous ni relevé : mêmes avions, mêmes cibles
+    lot.vider();
+    for (size_t i = 0; i < n; ++i) {
+        Position p = copies[i]->getPosition();
+        lot.ajouter(p.getX(), p.getY(), p.getAltitude(), cibles[i].getX(), cibles[i].getY(), cibles[i].getAltitude(),
+            4000.f, 10.f, 1e9f, SEUIL_URGENCE_CARBURANT);
+    }
+    t = mesurer(ticks, [&] { avancerLot(lot); });
+    rapporter("cinematique.avancerLot", n, ticks * static_cast<int>(n), t / n);
+    return true;
+}
+
+// Relevé des positions de toute la flotte, avion par avion puis en une passe sur EtatFlotte
+static void benchReleveFlotte() {
+    const size_t n = 10000;
+    const int passes = 200;
+    std::vector<Position> positions = genererPositions(n, 11);
+    std::vector<std::unique_ptr<Avion>> avions = genererAvions(n, positions);
+    std::vector<uint32_t> emplacements;
+    for (auto& avion : avions) emplacements.push_back(avion->getEmplacement());
+
+    std::vector<Position> releve(n);
+    double t = mesurer(passes, [&] {
+        for (size_t i = 0; i < n; ++i) releve[i] = avions[i]->getPosition();
+    });
+    rapporter("flotte.releve.avion", n, passes * static_cast<int>(n), t / n);
+
+    t = mesurer(passes, [&] { EtatFlotte::getInstance().lirePositions(emplacements, releve); });
+    rapporter("flotte.releve.groupe", n, passes * static_cast<int>(n), t / n);
+}
+
+// Choix du prochain départ avec une longue file : tous les avions attendent au parking
+static void benchChoixDecollage() {
+    for (size_t n : { 10, 100, 1000, 10000 }) {
+        std::vector<Parking> parkings;
+        for (size_t i = 0; i < n; ++i) {
+            parkings.emplace_back("P" + std::to_string(i), Position(100.0 + i, 0, 0));
+        }
+        TWR twr(parkings, Position(0, 0, 0), 5000.f);
+
+        std::vector<std::unique_ptr<Avion>> avions = genererAvions(n, std::vector<Position>(n, Position(0, 0, 0)));
+
+        // Le choix fait rouler l'avion le plus éloigné : on le renvoie au parking pour garder la file pleine
+        Avion* elu = avions[n - 1].get();
+        std::vector<Avion*> prets;
+        int iterations = iterationsPour(n) * 10;
+        double t;
+        {
+            SilenceConsole silence;
+            for (size_t i = 0; i < n; ++i) {
+                avions[i]->setParking(&parkings[i]);
+                avions[i]->setEtat(EtatAvion::EN_ATTENTE_DECOLLAGE);
+                twr.enregistrerPourDecollage(avions[i].get());
+            }
+            t = mesurer(iterations, [&] {
+                prets.clear();
+                twr.choisirAvionsPourDecollage(prets);
+                twr.oublier(elu);
+                twr.enregistrerPourDecollage(elu);
+            });
+        }
+        rapporter("twr.choisirAvionsPourDecollage", n, iterations, t);
+    }
+}
+
+// Réservation puis libération d'un parking quand seuls les plus éloignés de la piste sont libres
+static void benchReservationParking() {
+    for (size_t n : { 10, 100, 1000, 10000 }) {
+        std::vector<Parking> parkings;
+        for (size_t i = 0; i < n; ++i) {
+            CategorieAvion gabarit = static_cast<CategorieAvion>(i % 3);
+            parkings.emplace_back("P" + std::to_string(i), Position(100.0 + i, 0, 0), gabarit);
+        }
+        TWR twr(parkings, Position(0, 0, 0), 5000.f);
+        Avion avion("BN", 4000.f, 5.f, 1e9f, 10.f, 5000.f, Position(0, 0, 0));
+        avion.setCategorie(CategorieAvion::LOURD);
+
+        // Parkings lourds occupés sauf le dernier
+        while (twr.getNombreParkingsLibres() > 2 * n / 3 + 1) twr.reserverParking(&avion);
+
+        int iterations = iterationsPour(n) * 100;
+        double t = mesurer(iterations, [&] {
+            Parking* parking = twr.reserverParking(&avion);
+            if (parking) parking->liberer();
+        });
+        rapporter("twr.reserverParking", n, iterations, t);
+    }
+}
+
+// Mise à jour de l'APP avec une pile d'attente profonde et une piste occupée
+static void benchMiseAJourAPP() {
+    for (size_t n : { 10, 100, 1000, 10000 }) {
+        Aeroport aeroport("Bench", Position(0, 0, 0));
+        APP& app = *aeroport.app;
+        Avion occupant("BN-piste", 4000.f, 5.f, 1e9f, 10.f, 5000.f, Position(0, 0, 0));
+
+        std::vector<std::unique_ptr<Avion>> avions = genererAvions(n, genererPositions(n, 11));
+        int iterations = iterationsPour(n) * 10;
+        double t;
+        {
+            SilenceConsole silence;
+            // Piste occupée par un avion qui ne la dégage jamais
+            aeroport.twr->autoriserAtterrissage(&occupant);
+            for (auto& avion : avions) {
+                avion->setDestination(&aeroport);
+                app.ajouterAvion(avion.get());
+                app.mettreEnAttente(avion.get());
+            }
+            t = mesurer(iterations, [&] { app.mettreAJour(); });
+        }
+        rapporter("app.mettreAJour", n, iterations, t);
+        delete aeroport.app;
+        delete aeroport.twr;
+    }
+}
+
+// Cycle de vie complet d'un vol dans le registre, en régime établi : création, route en croisière,
+// approche planifiée, retrait et recyclage, avec n vols présents à la fois. Après l'échauffement,
+// chaque vol reprend un emplacement recyclé : on compte aussi les allocations par vol.
+static void benchRecyclage() {
+    const size_t n = 256;
+    const int vols = 200000;
+    Aeroport aeroport("Bench", Position(0, 0, 0));
+    RegistreAvions registre;
+    registre.reserver(n);
+    std::vector<PoigneeAvion> presents(n);
+    std::vector<Position> approche;
+    std::vector<Position> positions = genererPositions(n, 13);
+    auto oublier = [](Avion*) {};
+
+    auto vol = [&](size_t k) {
+        // Comme Scenario::creerVol : les avions retirés sont recyclés avant chaque création
+        registre.retirer(presents[k]);
+        registre.recycler(oublier);
+        presents[k] = registre.creer("BN-" + std::to_string(k % 1000), 4000.f, 5.f, 1e9f, 10.f, 5000.f, positions[k]);
+        Avion* avion = registre.trouver(presents[k]);
+        avion->setDestination(&aeroport);
+        avion->setTrajectoire({ Position(0, 0, 3000), Position(100000, 0, 10000) });
+        GestionnaireArrivees::approcheStandard(aeroport.position, approche);
+        avion->setTrajectoire(approche);
+    };
+
+    // Échauffement : n vols pour remplir le registre, autant pour passer par le recyclage
+    for (size_t k = 0; k < 2 * n; ++k) vol(k % n);
+
+    unsigned long long allocationsAvant = nbAllocations.load();
+    size_t suivant = 0;
+    double t = mesurer(vols, [&] {
+        vol(suivant);
+        suivant = (suivant + 1) % n;
+    });
+    double allocationsParVol = static_cast<double>(nbAllocations.load() - allocationsAvant) / vols;
+
+    rapporter("registre.vol", n, vols, t);
+    std::cout << "  allocations par vol : " << std::setprecision(3) << allocationsParVol
+        << ", emplacements : " << registre.getNbEmplacements() << "\n";
+    registre.vider();
+    delete aeroport.app;
+    delete aeroport.twr;
+}
+
+// Analyse d'un fichier de scénario de n aéroports et 10 n vols, avec vérification que les
+// nombres mal formés ou hors limites et les types sans parking à leur taille sont refusés
+static bool benchAnalyseScenario() {
+    const std::string base = "aeroport A 0 0\nparking P1 100 0 MOYEN\naeroport B 100000 0\n"
+        "type T 4000 5 5000 10 5000 MOYEN\n";
+    DescriptionScenario scenario;
+    std::string erreur;
+    if (!analyserScenario(base, scenario, erreur)) {
+        std::cerr << "[BENCH] Scenario de reference refuse : " << erreur << "\n";
+        return false;
+    }
+    for (const char* ligne : { "aeroport C nan 0", "aeroport C 0 inf", "aeroport C 0 0 nan", "aeroport C 0 0 1000 2x",
+        "parking P2 -nan 0", "type U nan 5 5000 10 5000", "type U 4000 5 5000 10 infinity",
+        "type L 4000 5 5000 10 5000 LOURD", "vol nan A B", "vol inf A B", "vol 1e300 A B", "vol 2147484 A B",
+        "vol 12abc A B", "vol -1 A B" }) {
+        if (analyserScenario(base + ligne + "\n", scenario, erreur)) {
+            std::cerr << "[BENCH] Ligne de scenario acceptee a tort : " << ligne << "\n";
+            return false;
+        }
+    }
+
+    for (size_t n : { 10, 100, 1000 }) {
+        std::string texte;
+        for (size_t i = 0; i < n; ++i) {
+            texte += "aeroport X" + std::to_string(i) + " " + std::to_string(i * 50000) + " 0 20000 2\n";
+        }
+        texte += "type T 4000 5 5000 10 5000 MOYEN\n";
+        for (size_t i = 0; i < 10 * n; ++i) {
+            texte += "vol " + std::to_string(i) + " X" + std::to_string(i % n) + " X" + std::to_string((i + 1) % n) + " T\n";
+        }
+        double t = mesurer(iterationsPour(n), [&] { analyserScenario(texte, scenario, erreur); });
+        rapporter("scenario.analyse", n, iterationsPour(n), t);
+    }
+    return true;
+}
+
+// Débit du journal : N producteurs, vidage du tampon compris dans la mesure
+static void benchJournal() {
+    Logger& logger = Logger::getInstance();
+    const int parProducteur = 100000;
+
+    for (ModeLogger mode : { ModeLogger::SYNCHRONE, ModeLogger::ASYNCHRONE }) {
+        for (size_t producteurs : { 1, 2, 4, 8 }) {
+            auto debut = std::chrono::steady_clock::now();
+            logger.configurer(mode, PolitiqueSaturation::BLOQUER);
+
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < producteurs; ++p) {
+                threads.emplace_back([&logger, p] {
+                    for (int i = 0; i < parProducteur; ++i) {
+                        logger.evenement(ActeurLog::AVION, ActionLog::URGENCE, static_cast<uint32_t>(p), 0, 1.f, 2.f, 3.f);
+                    }
+                });
+            }
+            for (auto& t : threads) t.join();
+            logger.configurer(ModeLogger::SYNCHRONE, PolitiqueSaturation::BLOQUER);
+            auto fin = std::chrono::steady_clock::now();
+
+            int total = parProducteur * static_cast<int>(producteurs);
+            double us = std::chrono::duration<double, std::micro>(fin - debut).count() / total;
+            rapporter(mode == ModeLogger::SYNCHRONE ? "logger.synchrone" : "logger.asynchrone", producteurs, total, us);
+        }
+    }
+}
+
+// Moteur à événements avec et sans sauts, même graine : les messages des contrôleurs et des
+// avions (toutes leurs décisions, dans l'ordre) doivent être identiques
+static bool benchSauts() {
+    const int nbAvions = 50;
+    const long long dureeMs = 600000;
+
+    // Les deux mondes sont prêts avant de jouer le premier : l'horloge commune en est au même
+    // instant pour les deux, et arreter() (destructeur) coupe toute la simulation
+    std::unique_ptr<Scenario> scenarios[2];
+    std::ostringstream messages[2];
+    for (int i = 0; i < 2; ++i) {
+        SilenceConsole capture(messages[i].rdbuf());
+        scenarios[i] = std::make_unique<Scenario>();
+        scenarios[i]->fixerGraine(7);
+        scenarios[i]->utiliserMoteurEvenements(i == 0);
+        scenarios[i]->demarrerControleurs();
+        scenarios[i]->genererTrafic(nbAvions, 1000);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        double us;
+        {
+            SilenceConsole capture(messages[i].rdbuf());
+            us = mesurer(1, [&] { scenarios[i]->avancer(dureeMs); });
+        }
+        rapporter(i == 0 ? "moteur.sauts" : "moteur.sans_sauts", nbAvions, 1, us);
+    }
+
+    if (scenarios[0]->getMoteur()->getNbPasSautes() == 0) {
+        std::cerr << "[BENCH] Aucun pas saute par le moteur a evenements !\n";
+        return false;
+    }
+    if (messages[0].str() != messages[1].str()) {
+        std::cerr << "[BENCH] Les sauts du moteur a evenements changent la simulation !\n";
+        return false;
+    }
+    SilenceConsole silence;
+    scenarios[0].reset();
+    scenarios[1].reset();
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string cheminJSON;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) cheminJSON = argv[++i];
+    }
+
+    // Le journal part en binaire (img/logs.bin, non suivi) pour ne pas écraser logs.json
+    Logger::getInstance().setFormat(FormatJournal::BINAIRE);
+
+    std::cout << std::left << std::setw(34) << "cas" << std::right << std::setw(8) << "taille"
+        << std::setw(14) << "us/op" << std::setw(16) << "op/s" << "\n";
+
+    if (!benchDetection()) return 1;
+    benchCCR();
+    if (!benchAvancer()) return 1;
+    benchReleveFlotte();
+    benchChoixDecollage();
+    benchReservationParking();
+    benchMiseAJourAPP();
+    benchRecyclage();
+    if (!benchAnalyseScenario()) return 1;
+    benchJournal();
+    // En dernier : la fin d'un scénario arrête la simulation pour tout le programme
+    if (!benchSauts()) return 1;
+
+    if (!cheminJSON.empty()) {
+        if (!ecrireJSON(cheminJSON)) {
+            std::cerr << "Impossible de creer " << cheminJSON << "\n";
+            return 1;
+        }
+        std::cout << resultats.size() << " mesures ecrites dans " << cheminJSON << ".\n";
+    }
+    return 0;
+}
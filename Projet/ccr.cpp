@@ -1,16 +1,79 @@
 ﻿#include "avion.hpp"
+#include "indexspatial.hpp"
+#include "thread.hpp"
+#include "pool.hpp"
+#include "etatflotte.hpp"
+#include <limits>
+
+// Cellules de la grille d'horizon : deux avions de cellules non voisines sont au moins à cette distance
+static constexpr double TAILLE_HORIZON = 8 * SEPARATION_HORIZONTALE;
+// Marge ajoutée de part et d'autre à l'écart vertical minimal d'une résolution anticipée
+static constexpr double MARGE_RESOLUTION = 50.0;
+// Décalage minimal de chaque avion, celui de la résolution réactive : disperse les niveaux
+static constexpr double DECALAGE_MIN_RESOLUTION = 500.0;
+// Cellules maximales de la grille de prédiction : au-delà, l'horizon de la passe est raccourci
+// (les paires plus éloignées sont reprises aux passes suivantes, quand l'horizon a glissé)
+static constexpr double PORTEE_PREDICTION_MAX = 4 * SEPARATION_HORIZONTALE;
+static constexpr double PORTEE_VERTICALE_PREDICTION_MAX = 4 * SEPARATION_VERTICALE;
+
+// Voisinage vertical de 2 couches : une paire écartée de moins de 2000 m peut être
+// ramenée sous le seuil par une séparation appliquée plus tôt dans la même passe
+CCR::Zone::Zone() : index(std::make_unique<IndexSpatial>(SEPARATION_HORIZONTALE, SEPARATION_VERTICALE, 2)),
+    lot(std::make_unique<LotRapprochements>()) {}
+
+CCR::Zone::~Zone() = default;
+
+CCR::CCR() : tailleSecteur_(0.0), horizonPas_(0.0), nbTransmissions_(0), nbResolutionsSecteursFermes_(0),
+    horizon_(std::make_unique<IndexSpatial>(TAILLE_HORIZON, 1e9, 0)) {}
+
+CCR::~CCR() = default;
+
+std::pair<int64_t, int64_t> CCR::cleSecteur(const Position& position) const {
+    if (tailleSecteur_ <= 0.0) return { 0, 0 };
+    return { static_cast<int64_t>(std::floor(position.getX() / tailleSecteur_)),
+        static_cast<int64_t>(std::floor(position.getY() / tailleSecteur_)) };
+}
+
+CCR::Zone& CCR::secteur(const std::pair<int64_t, int64_t>& cle) {
+    std::unique_ptr<Zone>& zone = secteurs_[cle];
+    if (!zone) zone = std::make_unique<Zone>();
+    return *zone;
+}
+
+void CCR::configurerSecteurs(double tailleSecteur, int nbTravailleurs) {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    tailleSecteur_ = std::max(0.0, tailleSecteur);
+    pool_ = (nbTravailleurs > 0) ? std::make_unique<PoolTravailleurs>(nbTravailleurs) : nullptr;
+
+    // Les avions déjà pris en charge rejoignent le secteur qu'ils survolent
+    std::vector<Avion*> avions;
+    for (auto& [cle, zone] : secteurs_) {
+        avions.insert(avions.end(), zone->avions.begin(), zone->avions.end());
+        nbResolutionsSecteursFermes_ += zone->nbResolutions;
+    }
+    secteurs_.clear();
+    for (Avion* avion : avions) {
+        secteur(cleSecteur(avion->getPosition())).avions.push_back(avion);
+    }
+}
+
+size_t CCR::getNbSecteurs() const {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    return secteurs_.size();
+}
 
-CCR::CCR() {}
+unsigned long long CCR::getNbTransmissions() const {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    return nbTransmissions_;
+}
 
 void CCR::prendreEnCharge(Avion* avion) {
     std::lock_guard<std::mutex> lock(mutexCCR_);
 
-    avionsEnCroisiere_.push_back(avion);
+    secteur(cleSecteur(avion->getPosition())).avions.push_back(avion);
     avion->setEtat(EtatAvion::EN_ROUTE);
 
     if (avion->getDestination()) {
-        std::vector<Position> routeEnRoute;
-        
         Position depart = avion->getPosition();
         Position dest = avion->getDestination()->position;
 
@@ -34,18 +97,16 @@ void CCR::prendreEnCharge(Avion* avion) {
             10000.0
         );
 
-        routeEnRoute.push_back(pointMontee);
-        routeEnRoute.push_back(pointCroisiere);
-        
-        avion->setTrajectoire(routeEnRoute);
+        // Liste d'initialisation : recopiée dans la trajectoire de l'avion, sans vecteur intermédiaire
+        avion->setTrajectoire({ pointMontee, pointCroisiere });
     }
     std::cout << "[CCR] CCR prend en charge " << avion->getNom()
         << ". Route vers "
         << (avion->getDestination() ? avion->getDestination()->nom : "N/A") << " transmise.\n";
 
-    std::stringstream ss;
-    ss << "Avion " << *avion << " pris en charge par la CCR, en destination de " << avion->getDestination()->nom;
-    Logger::getInstance().log("CCR", "Prise en charge", ss.str());
+    Logger& logger = Logger::getInstance();
+    logger.evenement(ActeurLog::CCR, ActionLog::PRISE_EN_CHARGE, avion->getId(),
+        logger.symbole(avion->getDestination()->nom), avion->getCarburant());
 }
 
 
@@ -61,58 +122,248 @@ void CCR::transfererVersApproche(Avion* avion, APP* appCible) {
     else {
         appCible->assignerTrajectoireApproche(avion);
     }
-    std::stringstream ss;
-    ss << "Transfert de " << *avion << " vers l'APP";
-    Logger::getInstance().log("CCR", "Transfert vers APP", ss.str());
+    Logger::getInstance().evenement(ActeurLog::CCR, ActionLog::TRANSFERT_APP, avion->getId(), 0, avion->getCarburant());
 }
 
-void CCR::gererEspaceAerien() {
-    std::lock_guard<std::mutex> lock(mutexCCR_);
+void CCR::separerAvions(Zone& zone, size_t i, size_t j) {
+    Avion* a1 = zone.avions[i];
+    Avion* a2 = zone.avions[j];
+    std::vector<Position>& positions = zone.positions;
 
-    for (size_t i = 0; i < avionsEnCroisiere_.size(); ++i) {
-        for (size_t j = i + 1; j < avionsEnCroisiere_.size(); ++j) {
-            Avion* a1 = avionsEnCroisiere_[i];
-            Avion* a2 = avionsEnCroisiere_[j];
+    Logger::getInstance().evenement(ActeurLog::CCR, ActionLog::COLLISION, a1->getId(), a2->getId());
+    ++zone.nbResolutions;
 
-            // Modification : Utilisation de >= pour éviter la double correction
-            // Si l'écart est déjà de 1000m (10500 vs 9500), on considère que c'est bon.
-            if (std::abs(a1->getPosition().getAltitude() - a2->getPosition().getAltitude()) >= 1000) {
-                continue;
-            }
+    zone.console << "[CCR] Alerte collision : " << a1->getNom() << " / " << a2->getNom() << ". Changement d'altitude pour les deux avions.\n";
+
+    // Avion 1 : Monte (Position + Trajectoire)
+    a1->decalerAltitude(500);
+    positions[i].setPosition(positions[i].getX(), positions[i].getY(), positions[i].getAltitude() + 500);
+
+    // Avion 2 : Descend (Position + Trajectoire)
+    a2->decalerAltitude(-500);
+    positions[j].setPosition(positions[j].getX(), positions[j].getY(), positions[j].getAltitude() - 500);
+}
+
+void CCR::resoudreConflitPrevu(Zone& zone, size_t i, size_t j, double debut, double fin) {
+    Avion* a1 = zone.avions[i];
+    Avion* a2 = zone.avions[j];
+    std::vector<Position>& positions = zone.positions;
+
+    // Écart vertical de i au-dessus de j, linéaire sur la branche : extrêmes aux bornes du conflit
+    double ecart = positions[i].getAltitude() - positions[j].getAltitude();
+    double vitesse = zone.branches[i].vz - zone.branches[j].vz;
+    double ecartDebut = ecart + vitesse * debut;
+    double ecartFin = ecart + vitesse * fin;
+
+    // Le plus haut sur le conflit monte, l'autre descend, chacun de la moitié du manque (au moins
+    // du décalage réactif, sinon les avions restent groupés au même niveau et se recroisent)
+    double sens = (ecartDebut + ecartFin >= 0.0) ? 1.0 : -1.0;
+    double manque = SEPARATION_VERTICALE - std::min(sens * ecartDebut, sens * ecartFin);
+    double decalage = sens * std::max(manque / 2.0 + MARGE_RESOLUTION, DECALAGE_MIN_RESOLUTION);
+
+    Logger::getInstance().evenement(ActeurLog::CCR, ActionLog::COLLISION, a1->getId(), a2->getId());
+    ++zone.nbResolutions;
+
+    zone.console << "[CCR] Conflit prevu dans " << static_cast<long long>(debut * PERIODE_PILOTE_MS) << " ms : "
+        << a1->getNom() << " / " << a2->getNom() << ". Ecart vertical porte a "
+        << static_cast<int>(std::min(sens * ecartDebut, sens * ecartFin) + 2.0 * std::fabs(decalage)) << " m au moins.\n";
+
+    a1->decalerAltitude(decalage);
+    positions[i].setPosition(positions[i].getX(), positions[i].getY(), positions[i].getAltitude() + decalage);
+    a2->decalerAltitude(-decalage);
+    positions[j].setPosition(positions[j].getX(), positions[j].getY(), positions[j].getAltitude() - decalage);
+}
+
+void CCR::relever(Zone& zone) {
+    // Une lecture par avion : positions en une passe sur l'état de la flotte, branche en cours
+    // en mode prédictif (sous le verrou de l'avion, avec sa position)
+    zone.positions.clear();
+    zone.branches.clear();
+    zone.pasMax = 0.0;
+    if (horizonPas_ <= 0.0) {
+        zone.emplacements.clear();
+        for (Avion* avion : zone.avions) zone.emplacements.push_back(avion->getEmplacement());
+        EtatFlotte::getInstance().lirePositions(zone.emplacements, zone.positions);
+        return;
+    }
 
-            double dist = a1->getPosition().distance(a2->getPosition());
-
-            if (dist < 20000.0) {
-                std::stringstream ss;
-                ss << "Séparation des avions pour éviter une collision : " << a1->getNom() << " - " << a2->getNom();
-                Logger::getInstance().log("CCR", "Collision", ss.str());
-
-                std::cout << "[CCR] Alerte collision : " << a1->getNom() << " / " << a2->getNom() << ". Changement d'altitude pour les deux avions.\n";
-
-                // Avion 1 : Monte (Position + Trajectoire)
-                Position p1 = a1->getPosition();
-                a1->setPosition(Position(p1.getX(), p1.getY(), p1.getAltitude() + 500));
-                
-                std::vector<Position> traj1 = a1->getTrajectoire();
-                for (auto& pt : traj1) {
-                    pt.setPosition(pt.getX(), pt.getY(), pt.getAltitude() + 500);
-                }
-                a1->setTrajectoire(traj1);
-
-                // Avion 2 : Descend (Position + Trajectoire)
-                Position p2 = a2->getPosition();
-                a2->setPosition(Position(p2.getX(), p2.getY(), p2.getAltitude() - 500));
-
-                std::vector<Position> traj2 = a2->getTrajectoire();
-                for (auto& pt : traj2) {
-                    pt.setPosition(pt.getX(), pt.getY(), pt.getAltitude() - 500);
-                }
-                a2->setTrajectoire(traj2);
+    for (Avion* avion : zone.avions) {
+        Position position, cible;
+        Branche branche{ 0.0, 0.0, 0.0, std::numeric_limits<double>::infinity() };
+        double longueurPas = avion->getVitesse() * DT_PILOTE;
+        if (avion->lireBranche(position, cible) && longueurPas > 0.0) {
+            double longueur = position.distance(cible);
+            if (longueur > 0.0) {
+                double k = longueurPas / longueur;
+                branche = { (cible.getX() - position.getX()) * k, (cible.getY() - position.getY()) * k,
+                    (cible.getAltitude() - position.getAltitude()) * k, longueur / longueurPas };
             }
+            // Au-delà du rayon de contrôle de la destination, l'APP reprend l'avion sur une autre route
+            if (Aeroport* destination = avion->getDestination()) {
+                double marge = position.distance(destination->position) - destination->rayonControle;
+                branche.pasRestants = std::min(branche.pasRestants, std::max(0.0, marge / longueurPas));
+            }
+        }
+        zone.pasMax = std::max(zone.pasMax, std::hypot(branche.vx, branche.vy));
+        zone.positions.push_back(position);
+        zone.branches.push_back(branche);
+    }
+}
+
+void CCR::separer(Zone& zone) {
+    if (horizonPas_ > 0.0) {
+        detecterConflitsPrevus(zone);
+        return;
+    }
+
+    zone.index->construire(zone.positions);
+    zone.index->pairesCandidates(zone.positions, zone.conflits);
+    if (!zone.origines.empty()) {
+        std::erase_if(zone.conflits, [&](const auto& paire) { return zone.origines[paire.first] == zone.origines[paire.second]; });
+    }
+
+    // Les paires sont traitées dans l'ordre (i, j) et retestées avec les altitudes déjà corrigées
+    for (const auto& [i, j] : zone.conflits) {
+        // Modification : Utilisation de >= pour éviter la double correction
+        // Si l'écart est déjà de 1000m (10500 vs 9500), on considère que c'est bon.
+        if (!enConflit(zone.positions[i], zone.positions[j])) {
+            continue;
+        }
+        separerAvions(zone, i, j);
+    }
+}
+
+void CCR::detecterConflitsPrevus(Zone& zone) {
+    const std::vector<Position>& positions = zone.positions;
+    double vzMax = 0.0;
+    for (const Branche& branche : zone.branches) vzMax = std::max(vzMax, std::fabs(branche.vz));
+
+    // Deux avions plus éloignés que la portée, horizontalement ou verticalement,
+    // ne peuvent pas perdre la séparation sur l'horizon. Avions rapides : horizon raccourci pour
+    // que la portée reste dans les cellules maximales (sinon presque toutes les paires sont candidates)
+    double horizon = horizonPas_;
+    if (zone.pasMax > 0.0) {
+        horizon = std::min(horizon, (PORTEE_PREDICTION_MAX - SEPARATION_HORIZONTALE) / (2.0 * zone.pasMax));
+    }
+    if (vzMax > 0.0) {
+        horizon = std::min(horizon, (PORTEE_VERTICALE_PREDICTION_MAX - SEPARATION_VERTICALE) / (2.0 * vzMax));
+    }
+    double portee = SEPARATION_HORIZONTALE + 2.0 * zone.pasMax * horizon;
+    double porteeVerticale = SEPARATION_VERTICALE + 2.0 * vzMax * horizon;
+    // Grille refaite quand la portée en sort ou n'en couvre plus que la moitié
+    if (!zone.indexPrediction || portee > zone.tailleCellulePrediction || porteeVerticale > zone.hauteurCellulePrediction
+        || 2.0 * portee < zone.tailleCellulePrediction) {
+        zone.tailleCellulePrediction = portee;
+        zone.hauteurCellulePrediction = porteeVerticale;
+        zone.indexPrediction = std::make_unique<IndexSpatial>(zone.tailleCellulePrediction, zone.hauteurCellulePrediction, 1);
+    }
+    zone.indexPrediction->construire(positions);
+    zone.indexPrediction->pairesCandidates(positions, zone.conflits);
+    if (!zone.origines.empty()) {
+        std::erase_if(zone.conflits, [&](const auto& paire) { return zone.origines[paire.first] == zone.origines[paire.second]; });
+    }
+
+    LotRapprochements& lot = *zone.lot;
+    lot.vider();
+    for (const auto& [i, j] : zone.conflits) {
+        const Branche& bi = zone.branches[i];
+        const Branche& bj = zone.branches[j];
+        lot.ajouter(positions[j].getX() - positions[i].getX(), positions[j].getY() - positions[i].getY(),
+            positions[j].getAltitude() - positions[i].getAltitude(),
+            bj.vx - bi.vx, bj.vy - bi.vy, bj.vz - bi.vz, std::min({ horizon, bi.pasRestants, bj.pasRestants }));
+    }
+    predireConflits(lot);
+
+    // Un conflit prévu sur l'horizon est résolu sur toute la partie commune des branches :
+    // sinon l'horizon glissant le redécouvrirait à chaque passe, un peu plus loin.
+    // Les paires sont traitées dans l'ordre (i, j) et retestées avec les altitudes déjà corrigées.
+    for (size_t k = 0; k < zone.conflits.size(); ++k) {
+        if (lot.debut[k] < 0.0) continue;
+        double debut, fin;
+        if (!conflitSurBranches(zone, k, debut, fin)) continue;
+        resoudreConflitPrevu(zone, zone.conflits[k].first, zone.conflits[k].second, debut, fin);
+    }
+}
+
+bool CCR::conflitSurBranches(const Zone& zone, size_t k, double& debut, double& fin) const {
+    const auto [i, j] = zone.conflits[k];
+    const LotRapprochements& lot = *zone.lot;
+    double duree = std::min(zone.branches[i].pasRestants, zone.branches[j].pasRestants);
+    intervalleConflit(lot.dx[k], lot.dy[k], zone.positions[j].getAltitude() - zone.positions[i].getAltitude(),
+        lot.vx[k], lot.vy[k], lot.vz[k], std::min(duree, 1e9), debut, fin);
+    return debut >= 0.0;
+}
+
+void CCR::oublier(const Avion* avion) {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    for (auto& [cle, zone] : secteurs_) std::erase(zone->avions, avion);
+    std::erase(frontiere_.avions, avion);
+}
+
+void CCR::setHorizonPrediction(long long horizonMs) {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    horizonPas_ = static_cast<double>(std::max(0LL, horizonMs)) / PERIODE_PILOTE_MS;
+}
+
+unsigned long long CCR::getNbResolutions() const {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    unsigned long long total = frontiere_.nbResolutions + nbResolutionsSecteursFermes_;
+    for (const auto& [cle, zone] : secteurs_) total += zone->nbResolutions;
+    return total;
+}
+
+void CCR::transmettreEntreSecteurs() {
+    std::vector<std::pair<Avion*, std::pair<int64_t, int64_t>>> sortants;
+    for (auto& [cle, zone] : secteurs_) {
+        std::erase_if(zone->avions, [&](Avion* avion) {
+            std::pair<int64_t, int64_t> cible = cleSecteur(avion->getPosition());
+            if (cible == cle) return false;
+            sortants.push_back({ avion, cible });
+            return true;
+        });
+    }
+
+    for (const auto& [avion, cible] : sortants) {
+        secteur(cible).avions.push_back(avion);
+        ++nbTransmissions_;
+    }
+}
+
+void CCR::construireFrontiere() {
+    // Une paire à cheval sur une limite ne peut être en conflit (ou le devenir sur l'horizon)
+    // que si ses deux avions sont à moins de la portée d'une limite de leur secteur
+    double pasMax = 0.0;
+    for (const auto& [cle, zone] : secteurs_) pasMax = std::max(pasMax, zone->pasMax);
+    // Portée bornée comme dans detecterConflitsPrevus : une paire plus éloignée n'y est pas testée
+    double portee = std::min(SEPARATION_HORIZONTALE + 2.0 * pasMax * horizonPas_, PORTEE_PREDICTION_MAX);
+
+    Zone& frontiere = frontiere_;
+    frontiere.avions.clear();
+    frontiere.positions.clear();
+    frontiere.branches.clear();
+    frontiere.origines.clear();
+    frontiere.pasMax = pasMax;
+
+    size_t rang = 0;
+    for (const auto& [cle, zone] : secteurs_) {
+        double xMin = cle.first * tailleSecteur_, yMin = cle.second * tailleSecteur_;
+        for (size_t i = 0; i < zone->avions.size(); ++i) {
+            const Position& p = zone->positions[i];
+            double marge = std::min({ p.getX() - xMin, xMin + tailleSecteur_ - p.getX(),
+                p.getY() - yMin, yMin + tailleSecteur_ - p.getY() });
+            if (marge >= portee) continue;
+
+            frontiere.avions.push_back(zone->avions[i]);
+            frontiere.positions.push_back(p);
+            if (horizonPas_ > 0.0) frontiere.branches.push_back(zone->branches[i]);
+            frontiere.origines.push_back(rang);
         }
+        ++rang;
     }
+}
 
-    for (auto it = avionsEnCroisiere_.begin(); it != avionsEnCroisiere_.end(); ) {
+void CCR::transfererSortants(Zone& zone) {
+    for (auto it = zone.avions.begin(); it != zone.avions.end(); ) {
         Avion* avion = *it;
         Aeroport* destination = avion->getDestination();
 
@@ -126,13 +377,11 @@ void CCR::gererEspaceAerien() {
         if (avion->estEnUrgence()) {
             APP* appCible = destination->app;
 
-            std::stringstream ss;
-            ss << "Transfert prioritaire (urgence) de " << *avion << " vers APP";
-            Logger::getInstance().log("CCR", "Transfert d'urgence vers APP", ss.str());
+            Logger::getInstance().evenement(ActeurLog::CCR, ActionLog::TRANSFERT_URGENCE_APP, avion->getId(), 0, avion->getCarburant());
 
             std::cout << "[CCR] URGENCE " << avion->getNom() << " transfert de priorite.\n";
 
-            it = avionsEnCroisiere_.erase(it);
+            it = zone.avions.erase(it);
             transfererVersApproche(avion, appCible);
             continue;
         }
@@ -142,7 +391,7 @@ void CCR::gererEspaceAerien() {
 
             // Modification : Suppression du circuit d'attente CCR.
             // On transfère systématiquement à l'APP quand l'avion est à portée.
-            it = avionsEnCroisiere_.erase(it);
+            it = zone.avions.erase(it);
             transfererVersApproche(avion, appCible);
         }
         else {
@@ -151,15 +400,112 @@ void CCR::gererEspaceAerien() {
     }
 }
 
-Aeroport::Aeroport(std::string n, Position posAero, float rayon) : nom(n), position(posAero), rayonControle(rayon) {
-    Position posPiste(posAero.getX(), posAero.getY(), 0);
+void CCR::gererEspaceAerien() {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    bool sectorise = tailleSecteur_ > 0.0;
+    if (sectorise) transmettreEntreSecteurs();
+
+    // Chaque secteur ne touche qu'à ses avions : les secteurs se traitent en parallèle
+    std::vector<Zone*> zones;
+    for (auto& [cle, zone] : secteurs_) zones.push_back(zone.get());
+    auto traiter = [&](size_t debut, size_t fin) {
+        for (size_t k = debut; k < fin; ++k) {
+            relever(*zones[k]);
+            separer(*zones[k]);
+        }
+    };
+    if (pool_) pool_->executer(zones.size(), traiter);
+    else traiter(0, zones.size());
+
+    // Puis les paires à cheval sur deux secteurs voisins, avec les altitudes déjà corrigées
+    if (sectorise) {
+        construireFrontiere();
+        separer(frontiere_);
+    }
+
+    for (Zone* zone : zones) {
+        std::cout << zone->console.str();
+        zone->console.str("");
+    }
+    std::cout << frontiere_.console.str();
+    frontiere_.console.str("");
+
+    // Les transferts vers les APP restent séquentiels, dans l'ordre des secteurs
+    for (Zone* zone : zones) transfererSortants(*zone);
+
+    // Un secteur vidé est supprimé : il sera recréé quand un avion y reviendra
+    std::erase_if(secteurs_, [this](const auto& entree) {
+        if (!entree.second->avions.empty()) return false;
+        nbResolutionsSecteursFermes_ += entree.second->nbResolutions;
+        return true;
+    });
+}
+
+Aeroport::Aeroport(std::string n, Position posAero, float rayon, int nbPistes)
+    : Aeroport(n, posAero, rayon, nbPistes, {
+        // Les parkings sont du côté des x croissants, les pistes supplémentaires de l'autre
+        Parking(n + "-G1", Position(posAero.getX() + 100, posAero.getY(), 0)),
+        Parking(n + "-G2", Position(posAero.getX() + 300, posAero.getY(), 0)),
+        Parking(n + "-G3", Position(posAero.getX() + 600, posAero.getY(), 0)),
+        Parking(n + "-G4", Position(posAero.getX() + 800, posAero.getY(), 0)), // New
+        Parking(n + "-G5", Position(posAero.getX() + 1000, posAero.getY(), 0)) // New
+    }) {
+}
 
-    parkings.push_back(Parking(n + "-G1", Position(posAero.getX() + 100, posAero.getY(), 0)));
-    parkings.push_back(Parking(n + "-G2", Position(posAero.getX() + 300, posAero.getY(), 0)));
-    parkings.push_back(Parking(n + "-G3", Position(posAero.getX() + 600, posAero.getY(), 0)));
-    parkings.push_back(Parking(n + "-G4", Position(posAero.getX() + 800, posAero.getY(), 0))); // New
-    parkings.push_back(Parking(n + "-G5", Position(posAero.getX() + 1000, posAero.getY(), 0))); // New
+Aeroport::Aeroport(std::string n, Position posAero, float rayon, int nbPistes, std::vector<Parking> listeParkings)
+    : nom(n), position(posAero), rayonControle(rayon), parkings(std::move(listeParkings)),
+    gabaritMax(CategorieAvion::LEGER) {
+    for (const Parking& parking : parkings) gabaritMax = std::max(gabaritMax, parking.getGabarit());
+    std::vector<Position> pistes;
+    for (int i = 0; i < std::max(1, nbPistes); ++i) {
+        pistes.emplace_back(posAero.getX() - i * ESPACEMENT_PISTES, posAero.getY(), 0);
+    }
 
-    twr = new TWR(parkings, posPiste, 5000.f);
+    twr = new TWR(parkings, pistes, DUREE_OCCUPATION_PISTE_MS);
     app = new APP(twr);
 }
+
+bool Aeroport::accepte(CategorieAvion categorie) const {
+    return !parkings.empty() && categorie <= gabaritMax;
+}
+
+int CCR::pasSansIntervention(float dt) {
+    std::lock_guard<std::mutex> lock(mutexCCR_);
+    std::vector<Avion*> avions;
+    for (const auto& [cle, zone] : secteurs_) {
+        avions.insert(avions.end(), zone->avions.begin(), zone->avions.end());
+    }
+    if (avions.empty()) return std::numeric_limits<int>::max();
+
+    double nbPas = std::numeric_limits<int>::max();
+    double pasMax = 0.0;
+    positions_.clear();
+    for (Avion* avion : avions) {
+        Position position = avion->getPosition();
+        positions_.push_back(position);
+        double longueurPas = avion->getVitesse() * dt;
+        pasMax = std::max(pasMax, longueurPas);
+
+        Aeroport* destination = avion->getDestination();
+        if (!destination || avion->getEtat() != EtatAvion::EN_ROUTE) continue;
+        if (avion->estEnUrgence() || longueurPas <= 0.0) return 0;
+
+        // Transfert vers l'APP dès l'entrée dans le rayon de contrôle
+        double marge = position.distance(destination->position) - destination->rayonControle;
+        nbPas = std::min(nbPas, std::floor(marge / longueurPas) - 1);
+    }
+    if (pasMax <= 0.0) return 0;
+
+    // Deux avions se rapprochent au plus de 2 * pasMax par pas ; en mode prédictif, une passe
+    // intervient dès qu'une paire est à portée de perdre la séparation sur l'horizon
+    horizon_->construire(positions_);
+    horizon_->pairesCandidates(positions_, paires_);
+    double distanceMin = TAILLE_HORIZON;
+    for (const auto& [i, j] : paires_) {
+        distanceMin = std::min(distanceMin, positions_[i].distance(positions_[j]));
+    }
+    double portee = SEPARATION_HORIZONTALE + 2 * pasMax * horizonPas_;
+    nbPas = std::min(nbPas, std::floor((distanceMin - portee) / (2 * pasMax)) - 1);
+
+    return (nbPas > 0.0) ? static_cast<int>(nbPas) : 0;
+}
@@ -0,0 +1,77 @@
+#include "cinematique.hpp"
+#include <cmath>
+#include <limits>
+
+void LotCinematique::vider() {
+    x.clear(); y.clear(); z.clear();
+    cx.clear(); cy.clear(); cz.clear();
+    longueurPas.clear();
+    consoPas.clear();
+    carburant.clear();
+    seuilUrgence.clear();
+    atteint.clear();
+    panne.clear();
+    urgence.clear();
+}
+
+size_t LotCinematique::taille() const {
+    return x.size();
+}
+
+namespace {
+
+// Paramètres __restrict : sans eux le compilateur doit vérifier le recouvrement de treize tableaux
+// deux à deux et renonce à vectoriser
+void avancerTableaux(size_t n, double* __restrict x, double* __restrict y, double* __restrict z,
+    const double* __restrict cx, const double* __restrict cy, const double* __restrict cz,
+    const float* __restrict longueurPas, const float* __restrict consoPas,
+    float* __restrict carburant, const float* __restrict seuil,
+    uint8_t* __restrict atteint, uint8_t* __restrict panne, uint8_t* __restrict urgence) {
+    for (size_t i = 0; i < n; ++i) {
+        double px = x[i], py = y[i], pz = z[i];
+        double qx = cx[i], qy = cy[i], qz = cz[i];
+        float longueur = longueurPas[i];
+        float conso = consoPas[i];
+        float reservoir = carburant[i];
+        float limite = seuil[i];
+
+        // En panne sèche l'avion ne bouge pas : pas ramené à zéro plutôt qu'une écriture
+        // conditionnelle, et par un minimum pour que la lecture de longueurPas reste inconditionnelle
+        bool sec = reservoir < conso;
+        float plafond = sec ? 0.f : std::numeric_limits<float>::infinity();
+        float pas = longueur < plafond ? longueur : plafond;
+
+        float dx = static_cast<float>(qx - px);
+        float dy = static_cast<float>(qy - py);
+        float dz = static_cast<float>(qz - pz);
+        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+        bool arrive = dist <= pas;
+
+        // Direction indéfinie quand dist est nul : le point est alors atteint et elle n'est pas retenue
+        double nx = px + (dx / dist) * pas;
+        double ny = py + (dy / dist) * pas;
+        double nz = pz + (dz / dist) * pas;
+        x[i] = arrive ? qx : nx;
+        y[i] = arrive ? qy : ny;
+        z[i] = arrive ? qz : nz;
+
+        float reste = reservoir - conso;
+        carburant[i] = sec ? 0.f : reste;
+
+        atteint[i] = !sec & arrive;
+        panne[i] = sec;
+        urgence[i] = !sec & (reste < limite);
+    }
+}
+
+}
+
+void avancerLot(LotCinematique& lot) {
+    size_t n = lot.taille();
+    lot.atteint.resize(n);
+    lot.panne.resize(n);
+    lot.urgence.resize(n);
+    avancerTableaux(n, lot.x.data(), lot.y.data(), lot.z.data(), lot.cx.data(), lot.cy.data(), lot.cz.data(),
+        lot.longueurPas.data(), lot.consoPas.data(), lot.carburant.data(), lot.seuilUrgence.data(),
+        lot.atteint.data(), lot.panne.data(), lot.urgence.data());
+}
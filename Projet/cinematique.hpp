@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Avance d'un pas d'un groupe d'avions vers leur point visé, en structure de tableaux.
+// Mêmes formules qu'Avion::avancer et avancerSol (écarts et direction en float, position en
+// double), écrites sans branchement pour que le compilateur vectorise la normalisation, le pas
+// et le choix « point atteint » ; les issues sont rendues sous forme de masques.
+struct LotCinematique {
+    // Entrées : position, point visé, longueur et consommation du pas, carburant, seuil
+    // d'urgence carburant (négatif : pas de seuil)
+    std::vector<double> x, y, z;
+    std::vector<double> cx, cy, cz;
+    std::vector<float> longueurPas;
+    std::vector<float> consoPas;
+    std::vector<float> carburant;
+    std::vector<float> seuilUrgence;
+    // Sorties : position et carburant mis à jour en place, plus un masque par issue
+    std::vector<uint8_t> atteint;   // point visé atteint : l'avion y est posé
+    std::vector<uint8_t> panne;     // carburant insuffisant pour le pas : rien n'a bougé
+    std::vector<uint8_t> urgence;   // carburant sous le seuil à l'issue du pas
+
+    void vider();
+    // Dans l'en-tête : appelée pour chaque avion pendant le relevé
+    void ajouter(double x0, double y0, double z0, double cx0, double cy0, double cz0,
+        float longueur, float conso, float reservoir, float seuil) {
+        x.push_back(x0); y.push_back(y0); z.push_back(z0);
+        cx.push_back(cx0); cy.push_back(cy0); cz.push_back(cz0);
+        longueurPas.push_back(longueur);
+        consoPas.push_back(conso);
+        carburant.push_back(reservoir);
+        seuilUrgence.push_back(seuil);
+    }
+    size_t taille() const;
+};
+
+void avancerLot(LotCinematique& lot);
@@ -1,5 +1,6 @@
 ﻿#include "avion.hpp"
 #include <filesystem>
+#include "horloge.hpp"
 
 std::ostream& operator<<(std::ostream& os, const Position& pos) {
     os << "(" << (int)pos.x_ << ", " << (int)pos.y_ << ", Alt:" << (int)pos.altitude_ << ")";
@@ -11,9 +12,47 @@ std::ostream& operator<<(std::ostream& os, const Avion& avion) {
     return os;
 }
 
-Logger::Logger() : premierElement_(true) {
+Logger::Logger()
+    : premierElement_(true), ouvert_(false), format_(FormatJournal::JSON),
+    mode_(ModeLogger::SYNCHRONE), politique_(PolitiqueSaturation::BLOQUER),
+    masque_(0), posEcriture_(DEPOT_FERME), posLecture_(0), signal_(0), ecrivainEnAttente_(false),
+    ecrivainActif_(false), nbAbandonnes_(0) {
+}
+
+Logger::~Logger() {
+    arreterEcrivain();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ouvert_) ouvrir();
+    if (fichier_.is_open()) {
+        if (format_ == FormatJournal::JSON) fichier_ << "\n]";
+        fichier_.close();
+    }
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+void Logger::ouvrir() {
+    ouvert_ = true;
+
     std::filesystem::path cheminFichierSource = __FILE__;
     std::filesystem::path dossierProjet = cheminFichierSource.parent_path();
+
+    if (format_ == FormatJournal::BINAIRE) {
+        std::filesystem::path cheminLog = dossierProjet / "img" / "logs.bin";
+        fichier_.open(cheminLog, std::ios::binary);
+        if (fichier_.is_open()) {
+            fichier_.write(SIGNATURE_JOURNAL, sizeof(SIGNATURE_JOURNAL));
+            fichier_.write(reinterpret_cast<const char*>(&VERSION_JOURNAL), sizeof(VERSION_JOURNAL));
+        }
+        else {
+            std::cerr << "Impossible de creer img/logs.bin\n";
+        }
+        return;
+    }
+
     std::filesystem::path cheminLog = dossierProjet / "img" / "logs.json";
     fichier_.open(cheminLog);
     if (fichier_.is_open()) {
@@ -24,27 +63,256 @@ Logger::Logger() : premierElement_(true) {
     }
 }
 
-Logger::~Logger() {
-    if (fichier_.is_open()) {
-        fichier_ << "\n]";
-        fichier_.close();
+void Logger::setFormat(FormatJournal format) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ouvert_) format_ = format;
+}
+
+void Logger::configurer(ModeLogger mode, PolitiqueSaturation politique, size_t capacite) {
+    arreterEcrivain();
+
+    politique_ = politique;
+    if (mode == ModeLogger::ASYNCHRONE) {
+        size_t taille = 1;
+        while (taille < capacite) taille <<= 1;
+
+        anneau_ = std::make_unique<CelluleLog[]>(taille);
+        for (size_t i = 0; i < taille; ++i) {
+            anneau_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        masque_ = taille - 1;
+        posLecture_ = 0;
+        ecrivainEnAttente_ = false;
+        ecrivainActif_ = true;
+        posEcriture_ = 0;   // ouvre le dépôt
+        ecrivain_ = std::thread(&Logger::boucleEcrivain, this);
     }
+    mode_ = mode;
 }
 
-Logger& Logger::getInstance() {
-    static Logger instance;
-    return instance;
+ModeLogger Logger::getMode() const {
+    return mode_;
 }
 
-void Logger::log(const std::string& acteur, const std::string& action, const std::string& details) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (fichier_.is_open()) {
-        if (!premierElement_) fichier_ << ",\n";
-        fichier_ << "  {\n";
-        fichier_ << "    \"Controleur\": \"" << acteur << "\",\n";
-        fichier_ << "    \"Action\": \"" << action << "\",\n";
-        fichier_ << "    \"Details\": \"" << details << "\"\n";
-        fichier_ << "  }";
+unsigned long long Logger::getNbAbandonnes() const {
+    return nbAbandonnes_;
+}
+
+void Logger::nommerAvion(uint32_t id, const std::string& nom) {
+    std::lock_guard<std::mutex> lock(mutexNoms_);
+    noms_.nommerAvion(id, nom);
+}
+
+void Logger::oublierAvion(uint32_t id) {
+    EvenementJournal e{};
+    e.idAvion = id;
+    e.action = ActionLog::OUBLI_AVION;
+    // Jamais abandonné : le nom resterait en table
+    transmettre(e, false);
+}
+
+uint32_t Logger::symbole(const std::string& texte) {
+    // Un symbole ne change jamais d'identifiant une fois défini : chaque thread garde ceux qu'il a
+    // déjà demandés, et ne prend mutexNoms_ qu'à la première demande d'un texte
+    thread_local std::unordered_map<std::string, uint32_t> connus;
+    auto it = connus.find(texte);
+    if (it != connus.end()) return it->second;
+
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutexNoms_);
+        id = noms_.symbole(texte);
+    }
+    connus.emplace(texte, id);
+    return id;
+}
+
+void Logger::ecrireDefinition(ActionLog type, uint32_t id, const std::string& nom) {
+    EvenementJournal definition{};
+    definition.action = type;
+    definition.idAvion = id;
+    definition.reference = std::min(static_cast<uint32_t>(nom.size()), LONGUEUR_NOM_MAX);
+    fichier_.write(reinterpret_cast<const char*>(&definition), sizeof(definition));
+    fichier_.write(nom.data(), definition.reference);
+}
+
+bool Logger::marquerAvionDefini(uint32_t id) {
+    if (avionsDefinis_.contains(id)) return false;
+    if (definisLibres_.empty()) {
+        avionsDefinis_.insert(id);
+        return true;
+    }
+    auto noeud = std::move(definisLibres_.back());
+    definisLibres_.pop_back();
+    noeud.value() = id;
+    avionsDefinis_.insert(std::move(noeud));
+    return true;
+}
+
+// Appelé sous mutex_, par le producteur (mode synchrone) ou par le thread écrivain
+void Logger::ecrire(const EvenementJournal& e) {
+    if (e.action == ActionLog::OUBLI_AVION) {
+        std::lock_guard<std::mutex> lockNoms(mutexNoms_);
+        noms_.oublierAvion(e.idAvion);
+        auto noeud = avionsDefinis_.extract(e.idAvion);
+        if (!noeud.empty()) definisLibres_.push_back(std::move(noeud));
+        return;
+    }
+
+    if (!ouvert_) ouvrir();
+    if (!fichier_.is_open()) return;
+
+    std::lock_guard<std::mutex> lockNoms(mutexNoms_);
+
+    if (format_ == FormatJournal::JSON) {
+        ecrireEntreeJSON(fichier_, premierElement_, nomActeur(e.acteur), nomAction(e.action), formaterDetails(e, noms_));
         premierElement_ = false;
+        return;
     }
+
+    if (marquerAvionDefini(e.idAvion)) {
+        ecrireDefinition(ActionLog::DEFINITION_AVION, e.idAvion, noms_.nomAvion(e.idAvion));
+    }
+    if (e.action == ActionLog::COLLISION && marquerAvionDefini(e.reference)) {
+        ecrireDefinition(ActionLog::DEFINITION_AVION, e.reference, noms_.nomAvion(e.reference));
+    }
+    bool referenceSymbole = (e.action == ActionLog::PARKING)
+        || (e.action == ActionLog::PRISE_EN_CHARGE && e.acteur == ActeurLog::CCR);
+    if (referenceSymbole && symbolesDefinis_.insert(e.reference).second) {
+        ecrireDefinition(ActionLog::DEFINITION_SYMBOLE, e.reference, noms_.texteSymbole(e.reference));
+    }
+    fichier_.write(reinterpret_cast<const char*>(&e), sizeof(e));
+}
+
+// File bornée multi-producteurs à numéros de séquence : chaque case porte le numéro du
+// prochain tour qui peut l'utiliser, les producteurs se la disputent par CAS sur posEcriture_.
+// Le CAS réussi est séquentiel : avec le drapeau ecrivainEnAttente_ (lu par transmettre, levé
+// puis suivi d'une relecture de posEcriture_ par l'écrivain), l'un des deux voit l'autre.
+Logger::ResultatDepot Logger::deposer(const EvenementJournal& evenement) {
+    size_t pos = posEcriture_.load(std::memory_order_relaxed);
+    while (true) {
+        if (pos & DEPOT_FERME) return ResultatDepot::FERME;
+
+        CelluleLog& cellule = anneau_[pos & masque_];
+        size_t sequence = cellule.sequence.load(std::memory_order_acquire);
+        intptr_t ecart = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (ecart == 0) {
+            if (posEcriture_.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                cellule.donnees = evenement;
+                cellule.sequence.store(pos + 1, std::memory_order_release);
+                return ResultatDepot::DEPOSE;
+            }
+        }
+        else if (ecart < 0) {
+            return ResultatDepot::PLEIN;
+        }
+        else {
+            pos = posEcriture_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::anneauVide() const {
+    return (posEcriture_.load() & ~DEPOT_FERME) == posLecture_;
+}
+
+bool Logger::retirer(EvenementJournal& evenement) {
+    CelluleLog& cellule = anneau_[posLecture_ & masque_];
+    size_t sequence = cellule.sequence.load(std::memory_order_acquire);
+    if (sequence != posLecture_ + 1) return false;
+
+    evenement = cellule.donnees;
+    cellule.sequence.store(posLecture_ + masque_ + 1, std::memory_order_release);
+    ++posLecture_;
+    return true;
+}
+
+void Logger::boucleEcrivain() {
+    EvenementJournal evenement;
+    while (true) {
+        bool travail = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (retirer(evenement)) {
+                ecrire(evenement);
+                travail = true;
+            }
+            if (travail) fichier_.flush();
+        }
+
+        if (!ecrivainActif_) {
+            // Dernière vidange : le dépôt est fermé, mais un producteur peut encore finir
+            // de remplir une case qu'il a réservée avant la fermeture
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (!anneauVide()) {
+                if (retirer(evenement)) ecrire(evenement);
+                else std::this_thread::yield();
+            }
+            fichier_.flush();
+            return;
+        }
+        if (travail) continue;
+
+        unsigned int vu = signal_.load(std::memory_order_acquire);
+        ecrivainEnAttente_.store(true);
+        if (anneauVide() && ecrivainActif_) signal_.wait(vu, std::memory_order_acquire);
+        // Case réservée mais pas encore remplie : le producteur l'aura bientôt publiée
+        else if (!anneauVide()) std::this_thread::yield();
+        ecrivainEnAttente_.store(false, std::memory_order_relaxed);
+    }
+}
+
+// Le mode ne repasse en synchrone qu'une fois l'anneau vidé : aucun événement déposé n'est
+// perdu, et aucune écriture directe ne passe devant un événement encore dans l'anneau
+void Logger::arreterEcrivain() {
+    if (ecrivain_.joinable()) {
+        posEcriture_.fetch_or(DEPOT_FERME);
+        ecrivainActif_ = false;
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+        ecrivain_.join();
+    }
+    mode_ = ModeLogger::SYNCHRONE;
+}
+
+void Logger::evenement(ActeurLog acteur, ActionLog action, uint32_t idAvion,
+    uint32_t reference, float v0, float v1, float v2) {
+    EvenementJournal e{};
+    e.tempsMs = static_cast<uint64_t>(HorlogeSimulation::getInstance().maintenantMs());
+    e.idAvion = idAvion;
+    e.acteur = acteur;
+    e.action = action;
+    e.reference = reference;
+    e.valeurs[0] = v0;
+    e.valeurs[1] = v1;
+    e.valeurs[2] = v2;
+    transmettre(e, true);
+}
+
+void Logger::transmettre(const EvenementJournal& e, bool abandonnable) {
+    while (mode_.load() == ModeLogger::ASYNCHRONE) {
+        ResultatDepot resultat = deposer(e);
+        while (resultat == ResultatDepot::PLEIN) {
+            if (abandonnable && politique_ == PolitiqueSaturation::ABANDONNER) {
+                nbAbandonnes_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+            resultat = deposer(e);
+        }
+        if (resultat == ResultatDepot::DEPOSE) {
+            // Un seul réveil par attente : le premier producteur qui voit le drapeau le baisse
+            if (ecrivainEnAttente_.load() && ecrivainEnAttente_.exchange(false)) {
+                signal_.fetch_add(1, std::memory_order_release);
+                signal_.notify_one();
+            }
+            return;
+        }
+        // Fermeture en cours : attendre la dernière vidange avant d'écrire directement
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ecrire(e);
 }
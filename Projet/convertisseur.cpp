@@ -0,0 +1,69 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <vector>
+
+#include "journal.hpp"
+
+// Convertit un journal binaire (img/logs.bin) vers le format historique de logs.json,
+// enregistrement par enregistrement, sans charger le fichier en mémoire.
+// Usage : ConvertisseurJournal [entree.bin] [sortie.json]
+int main(int argc, char* argv[]) {
+    std::string cheminEntree = (argc > 1) ? argv[1] : "img/logs.bin";
+    std::string cheminSortie = (argc > 2) ? argv[2] : "img/logs.json";
+
+    std::ifstream entree(cheminEntree, std::ios::binary);
+    if (!entree.is_open()) {
+        std::cerr << "Impossible d'ouvrir " << cheminEntree << "\n";
+        return 1;
+    }
+
+    char signature[sizeof(SIGNATURE_JOURNAL)];
+    uint32_t version = 0;
+    entree.read(signature, sizeof(signature));
+    entree.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!entree || std::memcmp(signature, SIGNATURE_JOURNAL, sizeof(signature)) != 0 || version != VERSION_JOURNAL) {
+        std::cerr << cheminEntree << " n'est pas un journal binaire valide (version " << VERSION_JOURNAL << ").\n";
+        return 1;
+    }
+
+    std::ofstream sortie(cheminSortie);
+    if (!sortie.is_open()) {
+        std::cerr << "Impossible de creer " << cheminSortie << "\n";
+        return 1;
+    }
+
+    TableNoms noms;
+    std::string nom;
+    EvenementJournal e;
+    bool premier = true;
+    size_t nbEvenements = 0;
+
+    sortie << "[\n";
+    while (entree.read(reinterpret_cast<char*>(&e), sizeof(e))) {
+        if (e.action == ActionLog::DEFINITION_AVION || e.action == ActionLog::DEFINITION_SYMBOLE) {
+            // Longueur vérifiée avant la lecture : un journal tronqué ou corrompu ne doit pas
+            // faire lire (ni allouer) n'importe quelle quantité
+            if (e.reference > LONGUEUR_NOM_MAX) {
+                std::cerr << cheminEntree << " : definition de nom invalide (longueur " << e.reference << ").\n";
+                return 1;
+            }
+            nom.resize(e.reference);
+            if (!entree.read(nom.data(), e.reference)) {
+                std::cerr << cheminEntree << " : journal tronque dans une definition de nom.\n";
+                return 1;
+            }
+            if (e.action == ActionLog::DEFINITION_AVION) noms.nommerAvion(e.idAvion, nom);
+            else noms.definirSymbole(e.idAvion, nom);
+            continue;
+        }
+
+        ecrireEntreeJSON(sortie, premier, nomActeur(e.acteur), nomAction(e.action), formaterDetails(e, noms));
+        premier = false;
+        ++nbEvenements;
+    }
+    sortie << "\n]";
+
+    std::cout << nbEvenements << " evenements convertis vers " << cheminSortie << ".\n";
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "descriptionscenario.hpp"
+#include <fstream>
+#include <charconv>
+#include <array>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+DescriptionScenario DescriptionScenario::parDefaut() {
+    DescriptionScenario scenario;
+    scenario.aeroports.push_back({ "Paris", Position(0, 0, 0), 80000.0f, 2, {} });
+    scenario.aeroports.push_back({ "Lille", Position(93000, 331000, 0), 80000.0f, 1, {} });
+    scenario.aeroports.push_back({ "Marseille", Position(432000, -785000, 0), 80000.0f, 1, {} });
+    scenario.types.push_back({ "AF", 4000.f, 5.f, 5000.f, 10.f, 5000.f, CategorieAvion::MOYEN });
+    return scenario;
+}
+
+bool chargerScenario(const std::string& chemin, DescriptionScenario& scenario, std::string& erreur) {
+    std::ifstream fichier(chemin, std::ios::binary);
+    if (!fichier.is_open()) {
+        erreur = "impossible d'ouvrir " + chemin;
+        return false;
+    }
+
+    // Lu d'un bloc : l'analyse travaille ensuite sur des vues dans ce tampon
+    fichier.seekg(0, std::ios::end);
+    std::streamoff taille = fichier.tellg();
+    fichier.seekg(0, std::ios::beg);
+    std::string texte(static_cast<size_t>(std::max<std::streamoff>(taille, 0)), '\0');
+    fichier.read(texte.data(), static_cast<std::streamsize>(texte.size()));
+    if (!fichier) {
+        erreur = "lecture de " + chemin + " interrompue";
+        return false;
+    }
+    return analyserScenario(texte, scenario, erreur);
+}
+
+namespace {
+
+constexpr size_t MOTS_MAX = 8;
+// Les pauses du générateur de trafic se comptent en millisecondes dans un int
+constexpr double HEURE_MAX_S = std::numeric_limits<int>::max() / 1000;
+
+// Mots d'une ligne, commentaire retiré ; false si la ligne en a plus que MOTS_MAX
+bool decouper(std::string_view ligne, std::array<std::string_view, MOTS_MAX>& mots, size_t& nbMots) {
+    size_t diese = ligne.find('#');
+    if (diese != std::string_view::npos) ligne = ligne.substr(0, diese);
+
+    nbMots = 0;
+    size_t i = 0;
+    while (i < ligne.size()) {
+        while (i < ligne.size() && (ligne[i] == ' ' || ligne[i] == '\t' || ligne[i] == '\r')) ++i;
+        size_t debut = i;
+        while (i < ligne.size() && ligne[i] != ' ' && ligne[i] != '\t' && ligne[i] != '\r') ++i;
+        if (i == debut) break;
+        if (nbMots == MOTS_MAX) return false;
+        mots[nbMots++] = ligne.substr(debut, i - debut);
+    }
+    return true;
+}
+
+// Le mot entier doit être un nombre, fini (from_chars accepte nan et inf)
+template <typename Nombre>
+bool lireNombre(std::string_view mot, Nombre& valeur) {
+    const char* fin = mot.data() + mot.size();
+    auto [ptr, ec] = std::from_chars(mot.data(), fin, valeur);
+    if (ec != std::errc() || ptr != fin) return false;
+    if constexpr (std::is_floating_point_v<Nombre>) return std::isfinite(valeur);
+    return true;
+}
+
+bool lireCategorie(std::string_view mot, CategorieAvion& categorie) {
+    if (mot == "LEGER") categorie = CategorieAvion::LEGER;
+    else if (mot == "MOYEN") categorie = CategorieAvion::MOYEN;
+    else if (mot == "LOURD") categorie = CategorieAvion::LOURD;
+    else return false;
+    return true;
+}
+
+}
+
+bool analyserScenario(std::string_view texte, DescriptionScenario& scenario, std::string& erreur) {
+    DescriptionScenario lu;
+    std::map<std::string, uint32_t, std::less<>> indicesAeroports;
+    std::map<std::string, uint32_t, std::less<>> indicesTypes;
+    std::array<std::string_view, MOTS_MAX> mots;
+    size_t nbMots = 0;
+    int numeroLigne = 0;
+
+    auto echec = [&](const std::string& message) {
+        erreur = "ligne " + std::to_string(numeroLigne) + " : " + message;
+        return false;
+    };
+
+    size_t debut = 0;
+    while (debut < texte.size()) {
+        size_t fin = texte.find('\n', debut);
+        if (fin == std::string_view::npos) fin = texte.size();
+        std::string_view ligne = texte.substr(debut, fin - debut);
+        debut = fin + 1;
+        ++numeroLigne;
+
+        if (!decouper(ligne, mots, nbMots)) return echec("trop de champs");
+        if (nbMots == 0) continue;
+        std::string_view directive = mots[0];
+
+        if (directive == "aeroport") {
+            if (nbMots < 4 || nbMots > 6) return echec("aeroport <nom> <x> <y> [rayon_controle] [nb_pistes]");
+            DescriptionAeroport aeroport{ std::string(mots[1]), Position(), 100000.0f, 1, {} };
+            double x = 0, y = 0;
+            if (!lireNombre(mots[2], x) || !lireNombre(mots[3], y)) return echec("position invalide");
+            if (nbMots > 4 && (!lireNombre(mots[4], aeroport.rayonControle) || aeroport.rayonControle <= 0.f)) {
+                return echec("rayon de controle invalide");
+            }
+            if (nbMots > 5 && (!lireNombre(mots[5], aeroport.nbPistes) || aeroport.nbPistes < 1)) {
+                return echec("nombre de pistes invalide");
+            }
+            aeroport.position = Position(x, y, 0);
+            if (!indicesAeroports.emplace(aeroport.nom, static_cast<uint32_t>(lu.aeroports.size())).second) {
+                return echec("aeroport deja declare : " + aeroport.nom);
+            }
+            lu.aeroports.push_back(std::move(aeroport));
+        }
+        else if (directive == "parking") {
+            if (lu.aeroports.empty()) return echec("parking avant tout aeroport");
+            if (nbMots < 4 || nbMots > 5) return echec("parking <nom> <dx> <dy> [LEGER|MOYEN|LOURD]");
+            DescriptionParking parking{ std::string(mots[1]), 0, 0, CategorieAvion::LOURD };
+            if (!lireNombre(mots[2], parking.dx) || !lireNombre(mots[3], parking.dy)) return echec("position invalide");
+            if (nbMots > 4 && !lireCategorie(mots[4], parking.gabarit)) return echec("gabarit inconnu : " + std::string(mots[4]));
+            lu.aeroports.back().parkings.push_back(std::move(parking));
+        }
+        else if (directive == "type") {
+            if (nbMots < 7 || nbMots > 8) {
+                return echec("type <nom> <vitesse> <vitesse_sol> <carburant> <consommation> <duree_stationnement> [gabarit]");
+            }
+            TypeAvion type{ std::string(mots[1]), 0, 0, 0, 0, 0, CategorieAvion::MOYEN };
+            if (!lireNombre(mots[2], type.vitesse) || !lireNombre(mots[3], type.vitesseSol)
+                || !lireNombre(mots[4], type.carburant) || !lireNombre(mots[5], type.consommation)
+                || !lireNombre(mots[6], type.dureeStationnement)) {
+                return echec("performances invalides");
+            }
+            if (type.vitesse <= 0.f || type.vitesseSol <= 0.f || type.carburant <= 0.f || type.consommation < 0.f
+                || type.dureeStationnement < 0.f) {
+                return echec("performances hors limites");
+            }
+            if (nbMots > 7 && !lireCategorie(mots[7], type.categorie)) return echec("gabarit inconnu : " + std::string(mots[7]));
+            if (!indicesTypes.emplace(type.nom, static_cast<uint32_t>(lu.types.size())).second) {
+                return echec("type deja declare : " + type.nom);
+            }
+            lu.types.push_back(std::move(type));
+        }
+        else if (directive == "vol") {
+            VolProgramme vol{ 0, 0, 0, 0, {} };
+            double heureS = 0;
+            if (nbMots < 4 || nbMots > 6) return echec("vol <heure_s> <depart> <destination> [type] [nom]");
+            if (!lireNombre(mots[1], heureS) || heureS < 0 || heureS > HEURE_MAX_S) {
+                return echec("heure invalide (0 a " + std::to_string(static_cast<int>(HEURE_MAX_S)) + " s)");
+            }
+            auto depart = indicesAeroports.find(mots[2]);
+            auto destination = indicesAeroports.find(mots[3]);
+            if (depart == indicesAeroports.end()) return echec("aeroport inconnu : " + std::string(mots[2]));
+            if (destination == indicesAeroports.end()) return echec("aeroport inconnu : " + std::string(mots[3]));
+            if (depart->second == destination->second) return echec("depart et destination confondus");
+            if (nbMots > 4) {
+                auto type = indicesTypes.find(mots[4]);
+                if (type == indicesTypes.end()) return echec("type inconnu : " + std::string(mots[4]));
+                vol.type = type->second;
+            }
+            if (nbMots > 5) vol.nom = mots[5];
+            vol.heureMs = static_cast<long long>(heureS * 1000.0);
+            vol.depart = depart->second;
+            vol.destination = destination->second;
+            lu.vols.push_back(std::move(vol));
+        }
+        else {
+            return echec("directive inconnue : " + std::string(directive));
+        }
+    }
+
+    // Le trafic tire départ et destination distincts
+    if (lu.aeroports.size() < 2) {
+        erreur = "il faut au moins deux aeroports";
+        return false;
+    }
+    if (lu.types.empty()) lu.types = DescriptionScenario::parDefaut().types;
+
+    // Un avion sans parking à sa taille est évacué sur la piste à chaque arrivée : un type doit
+    // trouver un parking partout où il peut se poser (partout avec le trafic tiré au hasard)
+    std::vector<CategorieAvion> gabaritMax(lu.aeroports.size(), CategorieAvion::LOURD);
+    for (size_t i = 0; i < lu.aeroports.size(); ++i) {
+        const std::vector<DescriptionParking>& parkings = lu.aeroports[i].parkings;
+        if (parkings.empty()) continue;
+        gabaritMax[i] = CategorieAvion::LEGER;
+        for (const DescriptionParking& parking : parkings) gabaritMax[i] = std::max(gabaritMax[i], parking.gabarit);
+    }
+    auto incompatible = [&](const TypeAvion& type, size_t aeroport) {
+        if (type.categorie <= gabaritMax[aeroport]) return false;
+        erreur = "le type " + type.nom + " n'entre dans aucun parking de " + lu.aeroports[aeroport].nom;
+        return true;
+    };
+    if (lu.vols.empty()) {
+        for (const TypeAvion& type : lu.types) {
+            for (size_t i = 0; i < lu.aeroports.size(); ++i) {
+                if (incompatible(type, i)) return false;
+            }
+        }
+    }
+    for (const VolProgramme& vol : lu.vols) {
+        if (incompatible(lu.types[vol.type], vol.destination)) return false;
+    }
+
+    std::stable_sort(lu.vols.begin(), lu.vols.end(),
+        [](const VolProgramme& a, const VolProgramme& b) { return a.heureMs < b.heureMs; });
+
+    scenario = std::move(lu);
+    return true;
+}
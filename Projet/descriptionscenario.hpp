@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "avion.hpp"
+
+// Performances d'un type d'avion : mêmes grandeurs que le constructeur d'Avion
+struct TypeAvion {
+    std::string nom;
+    float vitesse;
+    float vitesseSol;
+    float carburant;
+    float consommation;
+    float dureeStationnement;
+    CategorieAvion categorie;
+};
+
+// Parking, placé par rapport à la position de son aéroport
+struct DescriptionParking {
+    std::string nom;
+    double dx, dy;
+    CategorieAvion gabarit;
+};
+
+struct DescriptionAeroport {
+    std::string nom;
+    Position position;
+    float rayonControle;
+    int nbPistes;
+    std::vector<DescriptionParking> parkings;   // vide : les parkings G1 à G5 d'Aeroport
+};
+
+// Vol du programme de trafic ; aéroports et type désignés par leur indice
+struct VolProgramme {
+    long long heureMs;          // depuis le lancement du trafic
+    uint32_t depart;
+    uint32_t destination;
+    uint32_t type;
+    std::string nom;            // vide : AF-<numéro du vol>
+};
+
+// Monde d'une simulation : aéroports, types d'avions et programme de trafic.
+// Sans programme, le trafic est tiré au hasard entre les aéroports (voir Scenario::genererTrafic).
+struct DescriptionScenario {
+    std::vector<DescriptionAeroport> aeroports;
+    std::vector<TypeAvion> types;               // au moins un
+    std::vector<VolProgramme> vols;             // par heure croissante
+
+    // Paris (deux pistes), Lille et Marseille, un seul type d'avion
+    static DescriptionScenario parDefaut();
+};
+
+// Fichier de scénario : texte, une directive par ligne, # jusqu'à la fin de la ligne en commentaire.
+//   aeroport <nom> <x> <y> [rayon_controle] [nb_pistes]
+//   parking <nom> <dx> <dy> [LEGER|MOYEN|LOURD]      (rattaché au dernier aéroport, nommé <aeroport>-<nom>)
+//   type <nom> <vitesse> <vitesse_sol> <carburant> <consommation> <duree_stationnement> [LEGER|MOYEN|LOURD]
+//   vol <heure_s> <depart> <destination> [type] [nom]
+// Les nombres sont finis (ni nan ni inf) ; heure_s va de 0 à 2147483 s, soit INT_MAX ms.
+// Un parking sans gabarit est LOURD : il accepte tous les avions. Un type sans gabarit est MOYEN.
+// Un vol ne désigne que des aéroports et des types déjà déclarés. Sans ligne type, le type par
+// défaut ; sans type précisé, un vol prend le premier. Les vols peuvent être dans le désordre.
+// Chaque vol doit trouver un parking à sa taille à destination ; sans programme, chaque type
+// dans chaque aéroport. Un aéroport sans ligne parking a les parkings G1 à G5, tous LOURD.
+// Après chaque escale, la destination suivante est tirée parmi les aéroports qui ont un parking
+// à la taille de l'avion.
+// Le fichier est lu d'un bloc puis analysé en une passe, sans copie des lignes : quelques
+// dizaines de millisecondes pour des milliers d'aéroports.
+// En cas d'erreur, renvoie false et decrit l'erreur (avec son numéro de ligne) dans erreur.
+bool chargerScenario(const std::string& chemin, DescriptionScenario& scenario, std::string& erreur);
+// Même analyse, sur un texte déjà en mémoire
+bool analyserScenario(std::string_view texte, DescriptionScenario& scenario, std::string& erreur);
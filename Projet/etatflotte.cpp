@@ -0,0 +1,79 @@
+#include "etatflotte.hpp"
+#include <iostream>
+#include <cstdlib>
+
+EtatFlotte::EtatFlotte() : prochainEmplacement_(0) {
+    for (auto& page : pages_) page.store(nullptr, std::memory_order_relaxed);
+}
+
+// Les avions peuvent être détruits après l'arrêt du programme principal : les pages restent
+EtatFlotte::~EtatFlotte() = default;
+
+EtatFlotte& EtatFlotte::getInstance() {
+    static EtatFlotte instance;
+    return instance;
+}
+
+uint32_t EtatFlotte::allouer() {
+    std::lock_guard<std::mutex> lock(mutexPages_);
+    if (!libres_.empty()) {
+        uint32_t emplacement = libres_.back();
+        libres_.pop_back();
+        return emplacement;
+    }
+    return prochainEmplacement_++;
+}
+
+bool EtatFlotte::estComplete() {
+    std::lock_guard<std::mutex> lock(mutexPages_);
+    return libres_.empty() && prochainEmplacement_ >= NB_PAGES_MAX * TAILLE_PAGE_FLOTTE;
+}
+
+void EtatFlotte::liberer(uint32_t emplacement) {
+    std::lock_guard<std::mutex> lock(mutexPages_);
+    libres_.push_back(emplacement);
+}
+
+PageFlotte& EtatFlotte::reserver(uint32_t emplacement) {
+    size_t indice = emplacement / TAILLE_PAGE_FLOTTE;
+    // RegistreAvions::creer refuse l'avion avant d'en arriver là
+    if (indice >= NB_PAGES_MAX) {
+        std::cerr << "[FLOTTE] Plus de " << NB_PAGES_MAX * TAILLE_PAGE_FLOTTE << " avions simultanes.\n";
+        std::abort();
+    }
+
+    PageFlotte* page = pages_[indice].load(std::memory_order_acquire);
+    if (page) return *page;
+
+    std::lock_guard<std::mutex> lock(mutexPages_);
+    page = pages_[indice].load(std::memory_order_relaxed);
+    if (!page) {
+        page = new PageFlotte();
+        pages_[indice].store(page, std::memory_order_release);
+    }
+    return *page;
+}
+
+const PageFlotte& EtatFlotte::page(uint32_t emplacement) const {
+    return *pages_[emplacement / TAILLE_PAGE_FLOTTE].load(std::memory_order_acquire);
+}
+
+void EtatFlotte::lirePositions(const std::vector<uint32_t>& emplacements, std::vector<Position>& positions) const {
+    positions.resize(emplacements.size());
+    for (size_t i = 0; i < emplacements.size(); ++i) {
+        positions[i] = page(emplacements[i]).position(emplacements[i] % TAILLE_PAGE_FLOTTE);
+    }
+}
+
+void EtatFlotte::lireEtats(const std::vector<uint32_t>& emplacements, std::vector<EtatAvion>& etats) const {
+    etats.resize(emplacements.size());
+    for (size_t i = 0; i < emplacements.size(); ++i) {
+        etats[i] = page(emplacements[i]).getEtat(emplacements[i] % TAILLE_PAGE_FLOTTE);
+    }
+}
+
+void EtatFlotte::ecrirePositions(const std::vector<uint32_t>& emplacements, const std::vector<Position>& positions) {
+    for (size_t i = 0; i < emplacements.size(); ++i) {
+        reserver(emplacements[i]).setPosition(emplacements[i] % TAILLE_PAGE_FLOTTE, positions[i]);
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include "avion.hpp"
+
+// TAILLE_PAGE_FLOTTE emplacements d'avions consécutifs, un tableau par champ :
+// une passe sur un champ de toute la flotte parcourt de la mémoire contiguë.
+// Un seul écrivain par avion, celui qui tient le verrou de l'Avion ; les lectures se font sans
+// verrou depuis n'importe quel thread. Les trois coordonnées sont publiées ensemble sous un
+// compteur de séquence (impair pendant l'écriture) : une lecture ne voit jamais une position mêlée.
+constexpr size_t TAILLE_PAGE_FLOTTE = 1024;
+
+struct PageFlotte {
+    std::atomic<uint32_t> sequence[TAILLE_PAGE_FLOTTE];
+    std::atomic<double> x[TAILLE_PAGE_FLOTTE];
+    std::atomic<double> y[TAILLE_PAGE_FLOTTE];
+    std::atomic<double> altitude[TAILLE_PAGE_FLOTTE];
+    std::atomic<float> carburant[TAILLE_PAGE_FLOTTE];
+    std::atomic<EtatAvion> etat[TAILLE_PAGE_FLOTTE];
+    std::atomic<TypeUrgence> urgence[TAILLE_PAGE_FLOTTE];
+    std::atomic<Aeroport*> destination[TAILLE_PAGE_FLOTTE];
+    // Point visé par la branche en cours (x NaN s'il n'y en a plus) : écrit et relu sous le verrou
+    // de l'Avion, pour que la physique par lots n'ait pas à suivre sa trajectoire
+    std::atomic<double> cibleX[TAILLE_PAGE_FLOTTE];
+    std::atomic<double> cibleY[TAILLE_PAGE_FLOTTE];
+    std::atomic<double> cibleZ[TAILLE_PAGE_FLOTTE];
+
+    // Coordonnées brutes, sans passer par Position (dont les accesseurs ne sont pas en ligne) :
+    // pour les passes groupées
+    void coordonnees(uint32_t rang, double& px, double& py, double& pz) const {
+        for (;;) {
+            uint32_t avant = sequence[rang].load(std::memory_order_acquire);
+            if (avant & 1u) continue;
+            px = x[rang].load(std::memory_order_relaxed);
+            py = y[rang].load(std::memory_order_relaxed);
+            pz = altitude[rang].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence[rang].load(std::memory_order_relaxed) == avant) return;
+        }
+    }
+
+    void setCoordonnees(uint32_t rang, double px, double py, double pz) {
+        uint32_t s = sequence[rang].load(std::memory_order_relaxed);
+        sequence[rang].store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        x[rang].store(px, std::memory_order_relaxed);
+        y[rang].store(py, std::memory_order_relaxed);
+        altitude[rang].store(pz, std::memory_order_relaxed);
+        sequence[rang].store(s + 2, std::memory_order_release);
+    }
+
+    Position position(uint32_t rang) const {
+        double px, py, pz;
+        coordonnees(rang, px, py, pz);
+        return Position(px, py, pz);
+    }
+
+    void setPosition(uint32_t rang, const Position& p) {
+        setCoordonnees(rang, p.getX(), p.getY(), p.getAltitude());
+    }
+
+    float getCarburant(uint32_t rang) const { return carburant[rang].load(std::memory_order_acquire); }
+    void setCarburant(uint32_t rang, float valeur) { carburant[rang].store(valeur, std::memory_order_release); }
+    EtatAvion getEtat(uint32_t rang) const { return etat[rang].load(std::memory_order_acquire); }
+    void setEtat(uint32_t rang, EtatAvion valeur) { etat[rang].store(valeur, std::memory_order_release); }
+    TypeUrgence getUrgence(uint32_t rang) const { return urgence[rang].load(std::memory_order_acquire); }
+    void setUrgence(uint32_t rang, TypeUrgence valeur) { urgence[rang].store(valeur, std::memory_order_release); }
+    Aeroport* getDestination(uint32_t rang) const { return destination[rang].load(std::memory_order_acquire); }
+    void setDestination(uint32_t rang, Aeroport* valeur) { destination[rang].store(valeur, std::memory_order_release); }
+
+    bool getCible(uint32_t rang, double& cx, double& cy, double& cz) const {
+        cx = cibleX[rang].load(std::memory_order_relaxed);
+        if (std::isnan(cx)) return false;
+        cy = cibleY[rang].load(std::memory_order_relaxed);
+        cz = cibleZ[rang].load(std::memory_order_relaxed);
+        return true;
+    }
+    void setCible(uint32_t rang, const Position* p) {
+        cibleX[rang].store(p ? p->getX() : std::numeric_limits<double>::quiet_NaN(), std::memory_order_relaxed);
+        if (!p) return;
+        cibleY[rang].store(p->getY(), std::memory_order_relaxed);
+        cibleZ[rang].store(p->getAltitude(), std::memory_order_relaxed);
+    }
+};
+
+// État dynamique de toute la flotte (position, état, carburant, urgence, destination, point visé), par
+// emplacement. Chaque Avion en prend un à sa construction et le rend à sa destruction : les
+// emplacements rendus sont repris en premier, si bien que le nombre de pages suit le plus grand
+// nombre d'avions vivants à la fois, et non le nombre d'avions créés depuis le début.
+// Chaque Avion y lit et écrit ses champs ; les contrôleurs et le visualiseur peuvent aussi relever
+// ou mettre à jour toute une liste d'avions en une passe.
+class EtatFlotte {
+private:
+    static constexpr size_t NB_PAGES_MAX = 4096;
+
+    std::array<std::atomic<PageFlotte*>, NB_PAGES_MAX> pages_;
+    std::mutex mutexPages_;
+    // Sous mutexPages_ : emplacements rendus (le dernier rendu est repris d'abord), et premier jamais servi
+    std::vector<uint32_t> libres_;
+    uint32_t prochainEmplacement_;
+
+    EtatFlotte();
+    ~EtatFlotte();
+
+    const PageFlotte& page(uint32_t emplacement) const;
+
+public:
+    static EtatFlotte& getInstance();
+
+    EtatFlotte(const EtatFlotte&) = delete;
+    EtatFlotte& operator=(const EtatFlotte&) = delete;
+
+    // Emplacement libre pour un nouvel avion, et sa restitution quand l'avion est détruit
+    uint32_t allouer();
+    // Plus aucun emplacement à donner : un Avion construit maintenant ferait échouer reserver
+    bool estComplete();
+    void liberer(uint32_t emplacement);
+    // Page qui contient l'emplacement (rang emplacement % TAILLE_PAGE_FLOTTE), créée au besoin
+    PageFlotte& reserver(uint32_t emplacement);
+
+    // Passes groupées : une valeur par emplacement, dans l'ordre d'emplacements
+    void lirePositions(const std::vector<uint32_t>& emplacements, std::vector<Position>& positions) const;
+    void lireEtats(const std::vector<uint32_t>& emplacements, std::vector<EtatAvion>& etats) const;
+    // Réservée à qui a l'exclusivité d'écriture sur ces avions (leurs verrous, ou aucun autre thread actif)
+    void ecrirePositions(const std::vector<uint32_t>& emplacements, const std::vector<Position>& positions);
+};
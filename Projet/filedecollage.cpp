@@ -0,0 +1,111 @@
+#include "filedecollage.hpp"
+
+FileDecollage::Phase FileDecollage::phasePour(EtatAvion etat, bool aUnParking) {
+    switch (etat) {
+    case EtatAvion::EN_ATTENTE_PISTE: return Phase::AU_SEUIL;
+    case EtatAvion::ROULE_VERS_PISTE: return Phase::EN_ROULAGE;
+    case EtatAvion::EN_ATTENTE_DECOLLAGE: return aUnParking ? Phase::AU_PARKING : Phase::HORS_SEQUENCE;
+    default: return Phase::HORS_SEQUENCE;
+    }
+}
+
+FileDecollage::FileDecollage() : prochaineSequence_(0) {
+}
+
+// Au parking, le plus éloigné de la piste passe d'abord ; à égalité, le premier enregistré
+bool FileDecollage::avant(const Entree& a, const Entree& b) {
+    if (a.phase != b.phase) return a.phase < b.phase;
+    if (a.phase == Phase::AU_PARKING && a.distancePiste != b.distancePiste) {
+        return a.distancePiste > b.distancePiste;
+    }
+    return a.sequence < b.sequence;
+}
+
+void FileDecollage::placer(size_t i, const Entree& entree) {
+    tas_[i] = entree;
+    positions_[entree.avion] = i;
+}
+
+void FileDecollage::monter(size_t i) {
+    Entree entree = tas_[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!avant(entree, tas_[parent])) break;
+        placer(i, tas_[parent]);
+        i = parent;
+    }
+    placer(i, entree);
+}
+
+void FileDecollage::descendre(size_t i) {
+    Entree entree = tas_[i];
+    size_t n = tas_.size();
+    for (;;) {
+        size_t enfant = 2 * i + 1;
+        if (enfant >= n) break;
+        if (enfant + 1 < n && avant(tas_[enfant + 1], tas_[enfant])) ++enfant;
+        if (!avant(tas_[enfant], entree)) break;
+        placer(i, tas_[enfant]);
+        i = enfant;
+    }
+    placer(i, entree);
+}
+
+void FileDecollage::reordonner(size_t i) {
+    if (i > 0 && avant(tas_[i], tas_[(i - 1) / 2])) monter(i);
+    else descendre(i);
+}
+
+bool FileDecollage::contient(const Avion* avion) const {
+    return positions_.count(avion) != 0;
+}
+
+void FileDecollage::ajouter(Avion* avion, Phase phase, double distancePiste, long long enregistrementMs) {
+    tas_.push_back({ avion, phase, distancePiste, prochaineSequence_++, enregistrementMs });
+    monter(tas_.size() - 1);
+}
+
+bool FileDecollage::retirer(const Avion* avion) {
+    auto it = positions_.find(avion);
+    if (it == positions_.end()) return false;
+
+    size_t i = it->second;
+    positions_.erase(it);
+    if (i + 1 < tas_.size()) {
+        placer(i, tas_.back());
+        tas_.pop_back();
+        reordonner(i);
+    }
+    else {
+        tas_.pop_back();
+    }
+    return true;
+}
+
+void FileDecollage::changerPhase(const Avion* avion, Phase phase) {
+    auto it = positions_.find(avion);
+    if (it == positions_.end() || tas_[it->second].phase == phase) return;
+    tas_[it->second].phase = phase;
+    reordonner(it->second);
+}
+
+bool FileDecollage::estVide() const {
+    return tas_.empty();
+}
+
+size_t FileDecollage::taille() const {
+    return tas_.size();
+}
+
+Avion* FileDecollage::tete() const {
+    return tas_.empty() ? nullptr : tas_.front().avion;
+}
+
+FileDecollage::Phase FileDecollage::phaseTete() const {
+    return tas_.empty() ? Phase::HORS_SEQUENCE : tas_.front().phase;
+}
+
+long long FileDecollage::enregistrementMs(const Avion* avion) const {
+    auto it = positions_.find(avion);
+    return (it == positions_.end()) ? -1 : tas_[it->second].enregistrementMs;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "avion.hpp"
+
+// File de décollage d'une TWR : tas binaire indexé (position de chaque avion dans le tas),
+// ordonné par phase puis, au parking, par distance à la piste décroissante, puis par ordre
+// d'enregistrement. La tête est donc le prochain avion à quitter son parking : le plus éloigné.
+// Une fois parti, l'avion est suivi par sa piste (Piste::getDepart) et passe derrière les
+// avions au parking, qu'il ne bloque plus.
+// Ajout, retrait et changement de phase en O(log n) ; n'est pas protégée, la TWR la verrouille.
+class FileDecollage {
+public:
+    enum class Phase : uint8_t {
+        AU_PARKING,     // EN_ATTENTE_DECOLLAGE, avec un parking
+        EN_ROULAGE,     // ROULE_VERS_PISTE
+        AU_SEUIL,       // EN_ATTENTE_PISTE
+        HORS_SEQUENCE   // décollage en cours, sans parking, terminé...
+    };
+
+    static Phase phasePour(EtatAvion etat, bool aUnParking);
+
+private:
+    struct Entree {
+        Avion* avion;
+        Phase phase;
+        double distancePiste;
+        uint64_t sequence;
+        long long enregistrementMs;
+    };
+
+    std::vector<Entree> tas_;
+    std::unordered_map<const Avion*, size_t> positions_;
+    uint64_t prochaineSequence_;
+
+    static bool avant(const Entree& a, const Entree& b);
+    void placer(size_t i, const Entree& entree);
+    void monter(size_t i);
+    void descendre(size_t i);
+    void reordonner(size_t i);
+
+public:
+    FileDecollage();
+
+    bool contient(const Avion* avion) const;
+    void ajouter(Avion* avion, Phase phase, double distancePiste, long long enregistrementMs);
+    bool retirer(const Avion* avion);
+    void changerPhase(const Avion* avion, Phase phase);
+
+    bool estVide() const;
+    size_t taille() const;
+    Avion* tete() const;
+    Phase phaseTete() const;
+    // Instant d'enregistrement de l'avion, -1 s'il n'est pas dans la file
+    long long enregistrementMs(const Avion* avion) const;
+};
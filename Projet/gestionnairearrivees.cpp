@@ -0,0 +1,109 @@
+#include "gestionnairearrivees.hpp"
+#include "thread.hpp"
+
+GestionnaireArrivees::GestionnaireArrivees(TWR* twr)
+    : twr_(twr), nbSequencees_(0), nbRetardees_(0), nbCreneauxRendus_(0), retardCumuleMs_(0), retardMaxMs_(0) {
+}
+
+void GestionnaireArrivees::approcheStandard(const Position& piste, std::vector<Position>& points) {
+    float px = piste.getX();
+    float py = piste.getY();
+
+    // Modification : Descente par paliers depuis l'altitude de croisière
+    points.assign({
+        Position(px, py + 20000, 4000), // 20km out, 4000m
+        Position(px, py + 10000, 2000), // 10km out, 2000m
+        Position(px, py + 3000, 1000),  // 3km out, 1000m
+        Position(px, py + 1000, 500)    // Finale
+    });
+}
+
+int GestionnaireArrivees::nbPas(const Position& depart, std::span<const Position> points, float longueurPas) {
+    int total = 0;
+    Position courant = depart;
+    for (const Position& point : points) {
+        total += static_cast<int>(std::ceil(courant.distance(point) / longueurPas));
+        courant = point;
+    }
+    return total;
+}
+
+Position GestionnaireArrivees::pointDegagement(const Position& a, const Position& b, int nbPasVises, float longueurPas) {
+    double ux = b.getX() - a.getX();
+    double uy = b.getY() - a.getY();
+    double uz = b.getAltitude() - a.getAltitude();
+    double longueur = std::sqrt(ux * ux + uy * uy + uz * uz);
+
+    // Branches de longueurs entières en pas (moins une marge pour l'arrondi de l'avion)
+    double ra = std::ceil(nbPasVises / 2.0) * longueurPas - 1.0;
+    double rb = std::floor(nbPasVises / 2.0) * longueurPas - 1.0;
+    if (ra - rb > longueur) rb = ra;
+    if (longueur < 1.0) {
+        // a et b confondus : aller-retour vers le nord
+        return Position(a.getX(), a.getY() + ra, a.getAltitude());
+    }
+    ux /= longueur; uy /= longueur; uz /= longueur;
+
+    // Intersection des sphères de rayons ra (centre a) et rb (centre b), dans le plan qui
+    // contient ab et la perpendiculaire horizontale à gauche de la route
+    double wx = -uy, wy = ux;
+    double norme = std::sqrt(wx * wx + wy * wy);
+    if (norme < 1e-9) { wx = 1.0; wy = 0.0; }
+    else { wx /= norme; wy /= norme; }
+
+    double x = (ra * ra - rb * rb + longueur * longueur) / (2.0 * longueur);
+    double y = std::sqrt(std::max(0.0, ra * ra - x * x));
+    return Position(a.getX() + x * ux + y * wx, a.getY() + x * uy + y * wy, a.getAltitude() + x * uz);
+}
+
+void GestionnaireArrivees::planifier(const Avion* avion, std::vector<Position>& trajectoire) {
+    Position depart = avion->getPosition();
+    float longueurPas = avion->getVitesse() * DT_PILOTE;
+    long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+
+    // Heure au plus tôt au repère de finale, par la piste principale
+    approcheStandard(twr_->getPositionPiste(), trajectoire);
+    int pasDirects = nbPas(depart, trajectoire, longueurPas);
+    CreneauArrivee creneau = twr_->reserverCreneauArrivee(avion, maintenant + pasDirects * PERIODE_PILOTE_MS);
+    ++nbSequencees_;
+
+    approcheStandard(twr_->getPositionPiste(avion), trajectoire);
+    pasDirects = nbPas(depart, trajectoire, longueurPas);
+    long long retard = creneau.debutMs - (maintenant + pasDirects * PERIODE_PILOTE_MS);
+    if (retard <= 0) return;
+
+    // Retard arrondi au pas supérieur : l'avion se présente au début de son créneau, sinon il
+    // arriverait en avance, le perdrait, et l'aurait fait garder pour rien à la piste
+    int pasRetard = static_cast<int>((retard + PERIODE_PILOTE_MS - 1) / PERIODE_PILOTE_MS);
+    float carburantDetour = avion->getConsommation() * DT_PILOTE * static_cast<float>(pasDirects + pasRetard);
+    if (retard > RETARD_MAX_ABSORBE_MS || avion->getCarburant() - carburantDetour <= SEUIL_URGENCE_CARBURANT) {
+        twr_->annulerCreneauArrivee(avion);
+        approcheStandard(twr_->getPositionPiste(), trajectoire);
+        ++nbCreneauxRendus_;
+        return;
+    }
+
+    // Première branche allongée du retard
+    int pasPremiere = nbPas(depart, std::span<const Position>(trajectoire.data(), 1), longueurPas);
+    Position degagement = pointDegagement(depart, trajectoire.front(), pasPremiere + pasRetard, longueurPas);
+    trajectoire.insert(trajectoire.begin(), degagement);
+
+    long long absorbe = static_cast<long long>(nbPas(depart, trajectoire, longueurPas) - pasDirects) * PERIODE_PILOTE_MS;
+    if (absorbe > 0) {
+        ++nbRetardees_;
+        retardCumuleMs_ += absorbe;
+        retardMaxMs_ = std::max(retardMaxMs_, absorbe);
+    }
+}
+
+void GestionnaireArrivees::annuler(const Avion* avion) {
+    twr_->annulerCreneauArrivee(avion);
+}
+
+void GestionnaireArrivees::completer(StatistiquesArrivee& stats) const {
+    stats.nbSequencees = nbSequencees_;
+    stats.nbRetardees = nbRetardees_;
+    stats.nbCreneauxRendus = nbCreneauxRendus_;
+    stats.retardMoyenMs = nbRetardees_ ? static_cast<double>(retardCumuleMs_) / nbRetardees_ : 0.0;
+    stats.retardMaxMs = retardMaxMs_;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <span>
+#include "avion.hpp"
+
+// Gestionnaire d'arrivées d'une APP. À la prise en charge, chaque avion reçoit de la TWR un
+// créneau d'atterrissage calé sur son heure d'arrivée au plus tôt au repère de finale. Le retard
+// est absorbé en entier d'avance en allongeant la première branche de l'approche (point de
+// dégagement latéral). Au-delà de RETARD_MAX_ABSORBE_MS, ou si le détour entamerait la réserve
+// de carburant, le créneau est rendu tout de suite (il bloquerait la piste pour rien) : l'avion
+// suit l'approche directe et retombe dans le cas général (première piste libre, sinon circuit
+// d'attente). Protégé par le verrou de l'APP.
+class GestionnaireArrivees {
+private:
+    TWR* twr_;
+    unsigned long long nbSequencees_;
+    unsigned long long nbRetardees_;
+    unsigned long long nbCreneauxRendus_;
+    long long retardCumuleMs_;
+    long long retardMaxMs_;
+
+    // Pas pilote pour parcourir les points depuis depart : un pas qui atteint un point s'y arrête
+    static int nbPas(const Position& depart, std::span<const Position> points, float longueurPas);
+    // Point par lequel passer de a à b en exactement nbPasVises pas (au moins la ligne droite)
+    static Position pointDegagement(const Position& a, const Position& b, int nbPasVises, float longueurPas);
+
+public:
+    // Quatre occupations de piste : un avion peut attendre derrière quatre mouvements
+    static constexpr long long RETARD_MAX_ABSORBE_MS = 4 * static_cast<long long>(DUREE_OCCUPATION_PISTE_MS);
+
+    explicit GestionnaireArrivees(TWR* twr);
+
+    // Descente par paliers vers le seuil de piste, écrite dans points
+    static void approcheStandard(const Position& piste, std::vector<Position>& points);
+
+    // Réserve le créneau de l'avion et écrit dans trajectoire son approche, allongée du retard ;
+    // trajectoire est un tampon de l'appelant, dont la capacité sert d'un vol à l'autre
+    void planifier(const Avion* avion, std::vector<Position>& trajectoire);
+    void annuler(const Avion* avion);
+    // Remplit la partie séquencement des statistiques de l'APP
+    void completer(StatistiquesArrivee& stats) const;
+};
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <charconv>
+
+#include "avion.hpp"
+#include "thread.hpp"
+#include "scenario.hpp"
+#include "horloge.hpp"
+
+// Simulateur sans fenêtre : même monde que le visualiseur, sans SFML.
+// Usage : SimulateurHeadless [duree_secondes_simulees] [nb_avions] [facteur] [nb_travailleurs]
+//                            [--graine N] [--enregistrer fichier] [--rejouer fichier] [--evenements] [--sans-sauts]
+//                            [--prediction ms] [--secteurs km] [--travailleurs-ccr n] [--scenario fichier]
+// facteur : 1 = temps réel, 10, 1000... ; 0 = au plus vite
+// nb_travailleurs : 0 = un thread par avion, sinon ordonnanceur à ticks fixes
+// --evenements : moteur à événements discrets, sans thread (facteur et nb_travailleurs ignorés)
+// --sans-sauts : le moteur joue chaque pas (référence pour vérifier les sauts, même résultat plus lentement)
+// --prediction : la CCR anticipe les conflits sur cet horizon de temps simulé (0 = réactive)
+// --secteurs : la CCR découpe l'espace aérien en secteurs carrés de ce côté (0 = un seul secteur),
+// traités en parallèle par --travailleurs-ccr threads (0 = par le thread de la CCR)
+// --scenario : aéroports, types d'avions et programme de trafic lus dans le fichier (format dans
+// descriptionscenario.hpp, exemples dans scenarios/) ; s'il a un programme, nb_avions est ignoré
+// --enregistrer garde la graine, les paramètres et tous les tirages de l'exécution ;
+// --rejouer les reprend (les paramètres de la ligne de commande sont alors ignorés).
+// Seul le moteur à événements est reproductible : les deux demandent --evenements.
+
+// Le texte entier doit être un nombre
+template <typename Nombre>
+static bool lireNombre(const std::string& texte, Nombre& valeur) {
+    const char* fin = texte.data() + texte.size();
+    auto [ptr, ec] = std::from_chars(texte.data(), fin, valeur);
+    return !texte.empty() && ec == std::errc() && ptr == fin;
+}
+
+static int usage() {
+    std::cerr << "Usage : SimulateurHeadless [duree_secondes_simulees] [nb_avions] [facteur] [nb_travailleurs]\n"
+        << "                          [--graine N] [--enregistrer fichier] [--rejouer fichier] [--evenements] [--sans-sauts]\n"
+        << "                          [--prediction ms] [--secteurs km] [--travailleurs-ccr n] [--scenario fichier]\n";
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> positionnels;
+    std::string graine, cheminEnregistrement, cheminRejeu, cheminScenario;
+    bool evenements = false;
+    bool sauts = true;
+    long long horizonPredictionMs = 0;
+    double tailleSecteurKm = 0.0;
+    int travailleursCCR = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--graine" && i + 1 < argc) graine = argv[++i];
+        else if (arg == "--enregistrer" && i + 1 < argc) cheminEnregistrement = argv[++i];
+        else if (arg == "--rejouer" && i + 1 < argc) cheminRejeu = argv[++i];
+        else if (arg == "--scenario" && i + 1 < argc) cheminScenario = argv[++i];
+        else if (arg == "--evenements") evenements = true;
+        else if (arg == "--sans-sauts") sauts = false;
+        else if (arg == "--prediction" && i + 1 < argc) {
+            if (!lireNombre(argv[++i], horizonPredictionMs)) return usage();
+        }
+        else if (arg == "--secteurs" && i + 1 < argc) {
+            if (!lireNombre(argv[++i], tailleSecteurKm)) return usage();
+        }
+        else if (arg == "--travailleurs-ccr" && i + 1 < argc) {
+            if (!lireNombre(argv[++i], travailleursCCR)) return usage();
+        }
+        else if (arg.rfind("--", 0) == 0) return usage();
+        else positionnels.push_back(arg);
+    }
+
+    // Positionnels : durée, nombre d'avions, facteur, nombre de travailleurs
+    size_t n = positionnels.size();
+    int dureeLue = 60, nbAvions = 5, nbTravailleursLu = 0;
+    double facteurLu = 1.0;
+    if (n > 4 || (n > 0 && !lireNombre(positionnels[0], dureeLue)) || (n > 1 && !lireNombre(positionnels[1], nbAvions))
+        || (n > 2 && !lireNombre(positionnels[2], facteurLu)) || (n > 3 && !lireNombre(positionnels[3], nbTravailleursLu))) {
+        return usage();
+    }
+
+    DescriptionScenario description = DescriptionScenario::parDefaut();
+    double chargementMs = 0.0;
+    if (!cheminScenario.empty()) {
+        std::string erreur;
+        auto debut = std::chrono::steady_clock::now();
+        if (!chargerScenario(cheminScenario, description, erreur)) {
+            std::cerr << cheminScenario << " : " << erreur << "\n";
+            return 1;
+        }
+        chargementMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count();
+    }
+
+    // Threads et ordonnanceur à ticks entrelacent pilotes et contrôleurs au gré du système :
+    // un rejeu n'y retrouverait pas les tirages dans le même ordre
+    if ((!cheminEnregistrement.empty() || !cheminRejeu.empty()) && !evenements) {
+        std::cerr << "--enregistrer et --rejouer demandent --evenements (seul mode reproductible).\n";
+        return 1;
+    }
+    uint64_t valeurGraine = 0;
+    if (!graine.empty() && !lireNombre(graine, valeurGraine)) {
+        std::cerr << "Graine invalide : " << graine << " (entier positif attendu).\n";
+        return 1;
+    }
+
+    Scenario scenario(description);
+    if (!graine.empty()) scenario.fixerGraine(valeurGraine);
+    if (!cheminRejeu.empty() && !scenario.rejouerTirages(cheminRejeu)) {
+        std::cerr << cheminRejeu << " n'est pas un enregistrement de tirages valide.\n";
+        return 1;
+    }
+    if (!cheminEnregistrement.empty()) scenario.enregistrerTirages(cheminEnregistrement);
+
+    int dureeSecondes = static_cast<int>(scenario.entreeExterne("duree_s", dureeLue));
+    double facteur = scenario.entreeExterne("facteur", facteurLu);
+    int nbTravailleurs = static_cast<int>(scenario.entreeExterne("nb_travailleurs", nbTravailleursLu));
+
+    HorlogeSimulation::getInstance().setFacteur(facteur);
+    // Sur les noeuds de calcul, les contrôleurs ne doivent pas attendre l'écriture du journal
+    // Journal binaire compact : ConvertisseurJournal le remet au format logs.json
+    Logger::getInstance().setFormat(FormatJournal::BINAIRE);
+    Logger::getInstance().configurer(ModeLogger::ASYNCHRONE, PolitiqueSaturation::ABANDONNER);
+
+    std::cout << "===============================================\n";
+    std::cout << "   SIMULATEUR ATC - MODE HEADLESS              \n";
+    std::cout << "===============================================\n";
+
+    std::cout << "[HEADLESS] Graine " << scenario.getGraine()
+        << (scenario.getJournalTirages().getMode() == JournalTirages::Mode::REJEU ? " (rejeu)" : "") << ".\n";
+
+    if (!cheminScenario.empty()) {
+        std::cout << "[HEADLESS] Scenario " << cheminScenario << " : " << description.aeroports.size() << " aeroports, "
+            << description.types.size() << " types d'avions, " << description.vols.size() << " vols programmes (lu en "
+            << static_cast<long long>(chargementMs) << " ms).\n";
+    }
+
+    scenario.ccr.setHorizonPrediction(horizonPredictionMs);
+    scenario.ccr.configurerSecteurs(tailleSecteurKm * 1000.0, travailleursCCR);
+    if (evenements) scenario.utiliserMoteurEvenements(sauts);
+    else if (nbTravailleurs > 0) scenario.utiliserOrdonnanceur(nbTravailleurs);
+    scenario.demarrerControleurs();
+    scenario.genererTrafic(nbAvions, 1000);
+
+    scenario.avancer(dureeSecondes * 1000LL);
+    // Pilotes et contrôleurs arrêtés : le rapport ne se mêle pas à leurs messages et porte sur
+    // un monde figé
+    scenario.arreterActeurs();
+
+    std::cout << "[HEADLESS] Fin de la simulation apres " << dureeSecondes << " s simulees (facteur "
+        << facteur << ").\n";
+    for (Aeroport* aero : scenario.aeroports) {
+        StatistiquesDecollage stats = aero->twr->getStatistiquesDecollage();
+        std::cout << "[HEADLESS] " << aero->nom << " : " << stats.nbDecollages << " decollages, attente moyenne "
+            << static_cast<long long>(stats.attenteMoyenneMs / 1000) << " s (max " << stats.attenteMaxMs / 1000
+            << " s), file " << stats.profondeur << " (max " << stats.profondeurMax << ").\n";
+        if (stats.decollagesParPiste.size() > 1) {
+            std::cout << "[HEADLESS] " << aero->nom << " : decollages par piste";
+            for (size_t i = 0; i < stats.decollagesParPiste.size(); ++i) {
+                std::cout << (i ? ", " : " ") << "P" << (i + 1) << " " << stats.decollagesParPiste[i];
+            }
+            std::cout << ".\n";
+        }
+        StatistiquesArrivee arrivees = aero->app->getStatistiquesArrivee();
+        std::cout << "[HEADLESS] " << aero->nom << " : " << arrivees.nbSequencees << " arrivees sequencees, "
+            << arrivees.nbRetardees << " retardees en approche (moyenne " << static_cast<long long>(arrivees.retardMoyenMs)
+            << " ms, max " << arrivees.retardMaxMs << " ms), " << arrivees.nbCreneauxRendus << " creneaux rendus, "
+            << arrivees.nbRefus << " refus, "
+            << arrivees.nbMisesEnAttente << " mises en attente.\n";
+    }
+    std::cout << "[HEADLESS] CCR : " << scenario.ccr.getNbResolutions() << " resolutions de conflit, "
+        << scenario.ccr.getNbSecteurs() << " secteurs, " << scenario.ccr.getNbTransmissions()
+        << " transmissions entre secteurs.\n";
+    std::cout << "[HEADLESS] Flotte : " << scenario.flotte.getNbActifs() << " avions actifs, "
+        << scenario.flotte.getNbEmplacements() << " emplacements, " << scenario.flotte.getNbRecycles()
+        << " avions recycles.\n";
+    if (const MoteurEvenements* moteur = scenario.getMoteur()) {
+        std::cout << "[HEADLESS] Moteur a evenements : " << moteur->getNbEvenements() << " evenements traites, "
+            << moteur->getNbPasSautes() << " pas pilote sautes.\n";
+    }
+    scenario.arreter();
+
+    if (Logger::getInstance().getNbAbandonnes() > 0) {
+        std::cout << "[HEADLESS] " << Logger::getInstance().getNbAbandonnes() << " entrees de journal abandonnees.\n";
+    }
+    if (scenario.getJournalTirages().getNbDivergences() > 0) {
+        std::cout << "[HEADLESS] Rejeu divergent : " << scenario.getJournalTirages().getNbDivergences()
+            << " tirages non enregistres.\n";
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "horloge.hpp"
+
+// Nombre d'enregistrements du thread courant (un thread non enregistré qui attend
+// est compté comme participant le temps de son attente)
+static thread_local int participationLocale = 0;
+
+HorlogeSimulation::HorlogeSimulation()
+    : facteur_(1.0), baseSimMs_(0), baseReelle_(HorlogeReelle::now()),
+    maintenantMs_(0), participants_(0), attentesSansEcheance_(0), interrompue_(false) {
+}
+
+HorlogeSimulation& HorlogeSimulation::getInstance() {
+    static HorlogeSimulation instance;
+    return instance;
+}
+
+long long HorlogeSimulation::maintenantNonVerrouille() const {
+    if (facteur_ <= 0.0) return maintenantMs_;
+    auto ecoule = std::chrono::duration<double, std::milli>(HorlogeReelle::now() - baseReelle_).count();
+    return baseSimMs_ + static_cast<long long>(ecoule * facteur_);
+}
+
+HorlogeSimulation::HorlogeReelle::time_point HorlogeSimulation::instantReel(long long simMs) const {
+    auto reelMs = std::chrono::duration<double, std::milli>((simMs - baseSimMs_) / facteur_);
+    return baseReelle_ + std::chrono::duration_cast<HorlogeReelle::duration>(reelMs);
+}
+
+void HorlogeSimulation::avancerSiBloquee() {
+    if (facteur_ > 0.0 || echeances_.empty()) return;
+    if (static_cast<int>(echeances_.size()) + attentesSansEcheance_ < participants_) return;
+
+    // Tout le monde dort : on saute directement à la prochaine échéance
+    long long prochaine = *echeances_.begin();
+    if (prochaine > maintenantMs_) {
+        maintenantMs_ = prochaine;
+        reveillerTous();
+    }
+}
+
+void HorlogeSimulation::reveillerTous() {
+    cv_.notify_all();
+    for (SignalHorloge* signal : attentesSignal_) {
+        signal->cv_.notify_one();
+    }
+}
+
+// Retire une attente sur signal du décompte de la barrière
+void HorlogeSimulation::desinscrire(SignalHorloge& signal) {
+    if (!signal.inscrit_) return;
+    if (signal.avecEcheance_) echeances_.erase(signal.echeance_);
+    else --attentesSansEcheance_;
+    signal.inscrit_ = false;
+}
+
+void HorlogeSimulation::setFacteur(double facteur) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long maintenant = maintenantNonVerrouille();
+    facteur_ = facteur;
+    baseSimMs_ = maintenant;
+    maintenantMs_ = maintenant;
+    baseReelle_ = HorlogeReelle::now();
+    reveillerTous();
+}
+
+double HorlogeSimulation::getFacteur() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return facteur_;
+}
+
+long long HorlogeSimulation::maintenantMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maintenantNonVerrouille();
+}
+
+void HorlogeSimulation::imposerTemps(long long ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maintenantMs_ = ms;
+    baseSimMs_ = ms;
+}
+
+void HorlogeSimulation::attendre(long long ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (interrompue_) return;
+
+    bool temporaire = (participationLocale == 0);
+    if (temporaire) ++participants_;
+
+    long long echeance = maintenantNonVerrouille() + ms;
+
+    while (!interrompue_ && maintenantNonVerrouille() < echeance) {
+        if (facteur_ > 0.0) {
+            cv_.wait_until(lock, instantReel(echeance));
+        }
+        else {
+            auto it = echeances_.insert(echeance);
+            avancerSiBloquee();
+            cv_.wait(lock, [&] { return interrompue_ || facteur_ > 0.0 || maintenantMs_ >= echeance; });
+            echeances_.erase(it);
+        }
+    }
+
+    if (temporaire) {
+        --participants_;
+        avancerSiBloquee();
+    }
+}
+
+bool HorlogeSimulation::attendreSignal(SignalHorloge& signal, long long delaiMaxMs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    bool temporaire = (participationLocale == 0);
+    if (temporaire) ++participants_;
+
+    bool sansEcheance = delaiMaxMs < 0;
+    long long echeance = sansEcheance ? 0 : maintenantNonVerrouille() + delaiMaxMs;
+    auto expiree = [&] { return !sansEcheance && maintenantNonVerrouille() >= echeance; };
+
+    attentesSignal_.insert(&signal);
+    while (!interrompue_ && !signal.recu_ && !expiree()) {
+        if (facteur_ > 0.0) {
+            if (sansEcheance) signal.cv_.wait(lock);
+            else signal.cv_.wait_until(lock, instantReel(echeance));
+        }
+        else {
+            // Comptée comme en attente par la barrière tant que personne ne la signale
+            signal.inscrit_ = true;
+            signal.avecEcheance_ = !sansEcheance;
+            if (sansEcheance) ++attentesSansEcheance_;
+            else signal.echeance_ = echeances_.insert(echeance);
+            avancerSiBloquee();
+            signal.cv_.wait(lock, [&] { return interrompue_ || facteur_ > 0.0 || signal.recu_ || expiree(); });
+            desinscrire(signal);
+        }
+    }
+    attentesSignal_.erase(&signal);
+
+    bool recu = signal.recu_;
+    signal.recu_ = false;
+
+    if (temporaire) {
+        --participants_;
+        avancerSiBloquee();
+    }
+    return recu;
+}
+
+void HorlogeSimulation::signaler(SignalHorloge& signal) {
+    if (signal.rappel_) {
+        signal.rappel_();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (signal.recu_) return;
+    signal.recu_ = true;
+    // Le thread réveillé redevient actif tout de suite : l'horloge ne doit pas avancer sans lui
+    desinscrire(signal);
+    signal.cv_.notify_one();
+}
+
+void HorlogeSimulation::interrompre() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    interrompue_ = true;
+    reveillerTous();
+}
+
+void HorlogeSimulation::enregistrerParticipant() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++participants_;
+}
+
+void HorlogeSimulation::retirerParticipant() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --participants_;
+    avancerSiBloquee();
+}
+
+HorlogeSimulation::Participant::Participant() {
+    HorlogeSimulation::getInstance().enregistrerParticipant();
+    ++participationLocale;
+}
+
+HorlogeSimulation::Participant::Participant(Adopter) {
+    ++participationLocale;
+}
+
+HorlogeSimulation::Participant::~Participant() {
+    --participationLocale;
+    HorlogeSimulation::getInstance().retirerParticipant();
+}
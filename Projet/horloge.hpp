@@ -0,0 +1,92 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <set>
+#include <functional>
+
+// Réveil d'un thread qui attend sur l'horloge (HorlogeSimulation::attendreSignal) dès qu'un
+// autre thread lui signale du travail. Un signal émis hors attente est conservé jusqu'à la suivante.
+class SignalHorloge {
+public:
+    // Moteur à événements : signaler() appelle rappel (sans verrou) au lieu de réveiller un thread.
+    // À fixer avant toute émission.
+    void rediriger(std::function<void()> rappel) { rappel_ = std::move(rappel); }
+
+private:
+    friend class HorlogeSimulation;
+
+    std::function<void()> rappel_;
+    std::condition_variable cv_;
+    bool recu_ = false;
+    bool inscrit_ = false;        // attente en cours comptée par l'horloge (mode au plus vite)
+    bool avecEcheance_ = false;
+    std::multiset<long long>::iterator echeance_;
+};
+
+// Horloge de simulation partagée par toutes les routines.
+// facteur > 0 : le temps simulé s'écoule facteur fois plus vite que le temps réel (1x, 10x, 1000x...).
+// facteur = 0 : "au plus vite", le temps simulé saute à la prochaine échéance dès que
+//               tous les participants sont en attente.
+class HorlogeSimulation {
+private:
+    using HorlogeReelle = std::chrono::steady_clock;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    double facteur_;
+    long long baseSimMs_;
+    HorlogeReelle::time_point baseReelle_;
+    long long maintenantMs_;
+    int participants_;
+    std::multiset<long long> echeances_;
+    std::set<SignalHorloge*> attentesSignal_;
+    int attentesSansEcheance_;
+    bool interrompue_;
+
+    HorlogeSimulation();
+
+    long long maintenantNonVerrouille() const;
+    HorlogeReelle::time_point instantReel(long long simMs) const;
+    void avancerSiBloquee();
+    void reveillerTous();
+    void desinscrire(SignalHorloge& signal);
+
+public:
+    HorlogeSimulation(const HorlogeSimulation&) = delete;
+    HorlogeSimulation& operator=(const HorlogeSimulation&) = delete;
+
+    static HorlogeSimulation& getInstance();
+
+    void setFacteur(double facteur);
+    double getFacteur() const;
+    long long maintenantMs() const;
+    // Moteur à événements (facteur 0, aucun participant) : le temps est celui de l'événement traité
+    void imposerTemps(long long ms);
+
+    void attendre(long long ms);
+    // Attend que signal soit émis, au plus delaiMaxMs de temps simulé (< 0 : sans limite).
+    // Renvoie true si le réveil vient du signal, qui est alors consommé.
+    bool attendreSignal(SignalHorloge& signal, long long delaiMaxMs);
+    void signaler(SignalHorloge& signal);
+    void interrompre();
+
+    // Compte un participant de plus ; à appeler par le thread qui en lance un autre,
+    // avant sa création, pour que l'horloge ne puisse pas avancer sans lui
+    void enregistrerParticipant();
+    void retirerParticipant();
+
+    struct Adopter {};
+    static constexpr Adopter adopter{};
+
+    // Le thread courant est participant pendant la durée de vie de l'objet.
+    // Avec `adopter`, il reprend un enregistrement fait par le thread qui l'a lancé.
+    class Participant {
+    public:
+        Participant();
+        explicit Participant(Adopter);
+        ~Participant();
+        Participant(const Participant&) = delete;
+        Participant& operator=(const Participant&) = delete;
+    };
+};
@@ -0,0 +1,159 @@
+#include "indexspatial.hpp"
+
+bool enConflit(const Position& a, const Position& b) {
+    if (std::abs(a.getAltitude() - b.getAltitude()) >= SEPARATION_VERTICALE) return false;
+    return a.distance(b) < SEPARATION_HORIZONTALE;
+}
+
+void detecterConflitsForceBrute(const std::vector<Position>& positions, std::vector<PaireConflit>& conflits) {
+    conflits.clear();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        for (size_t j = i + 1; j < positions.size(); ++j) {
+            if (enConflit(positions[i], positions[j])) {
+                conflits.emplace_back(i, j);
+            }
+        }
+    }
+}
+
+void LotRapprochements::vider() {
+    dx.clear(); dy.clear(); dz.clear();
+    vx.clear(); vy.clear(); vz.clear();
+    duree.clear();
+}
+
+void LotRapprochements::ajouter(double dxj, double dyj, double dzj, double vxj, double vyj, double vzj, double dureej) {
+    dx.push_back(dxj); dy.push_back(dyj); dz.push_back(dzj);
+    vx.push_back(vxj); vy.push_back(vyj); vz.push_back(vzj);
+    duree.push_back(dureej);
+}
+
+size_t LotRapprochements::taille() const {
+    return dx.size();
+}
+
+// Corps commun, visible de la boucle de predireTableaux pour qu'elle soit vectorisée
+static inline void calculerIntervalle(double dx, double dy, double dz, double vx, double vy, double vz, double duree,
+    double& debut, double& fin) {
+    constexpr double EPSILON = 1e-9;
+    constexpr double INFINI = 1e300;
+
+    // Horizontal : |d + v t|² < S²  <=>  a t² + 2 b t + c < 0
+    double a = std::max(vx * vx + vy * vy, EPSILON);
+    double b = dx * vx + dy * vy;
+    double c = dx * dx + dy * dy - SEPARATION_HORIZONTALE * SEPARATION_HORIZONTALE;
+    double discriminant = b * b - a * c;
+    double racine = std::sqrt(std::max(discriminant, 0.0));
+    double hDebut = (-b - racine) / a;
+    double hFin = (-b + racine) / a;
+    hFin = (discriminant > 0.0) ? hFin : -INFINI;
+
+    // Vertical : |dz + vz t| < V ; sans vitesse verticale, toujours ou jamais
+    double vzSur = (std::abs(vz) > EPSILON) ? vz : EPSILON;
+    double t1 = (-SEPARATION_VERTICALE - dz) / vzSur;
+    double t2 = (SEPARATION_VERTICALE - dz) / vzSur;
+    bool plat = std::abs(vz) <= EPSILON;
+    bool proche = std::abs(dz) < SEPARATION_VERTICALE;
+    double vDebut = plat ? (proche ? -INFINI : INFINI) : std::min(t1, t2);
+    double vFin = plat ? (proche ? INFINI : -INFINI) : std::max(t1, t2);
+
+    double lo = std::max(std::max(0.0, hDebut), vDebut);
+    double hi = std::min(std::min(duree, hFin), vFin);
+    debut = (lo < hi) ? lo : -1.0;
+    fin = (lo < hi) ? hi : -1.0;
+}
+
+void intervalleConflit(double dx, double dy, double dz, double vx, double vy, double vz, double duree,
+    double& debut, double& fin) {
+    calculerIntervalle(dx, dy, dz, vx, vy, vz, duree, debut, fin);
+}
+
+namespace {
+
+// Paramètres __restrict : sans eux le compilateur doit vérifier le recouvrement des neuf tableaux
+// deux à deux et renonce à vectoriser
+void predireTableaux(size_t n, const double* __restrict dx, const double* __restrict dy, const double* __restrict dz,
+    const double* __restrict vx, const double* __restrict vy, const double* __restrict vz,
+    const double* __restrict duree, double* __restrict debut, double* __restrict fin) {
+    for (size_t k = 0; k < n; ++k) {
+        double d, f;
+        calculerIntervalle(dx[k], dy[k], dz[k], vx[k], vy[k], vz[k], duree[k], d, f);
+        debut[k] = d;
+        fin[k] = f;
+    }
+}
+
+}
+
+void predireConflits(LotRapprochements& lot) {
+    size_t n = lot.taille();
+    lot.debut.resize(n);
+    lot.fin.resize(n);
+    predireTableaux(n, lot.dx.data(), lot.dy.data(), lot.dz.data(), lot.vx.data(), lot.vy.data(), lot.vz.data(),
+        lot.duree.data(), lot.debut.data(), lot.fin.data());
+}
+
+IndexSpatial::IndexSpatial(double tailleHorizontale, double tailleVerticale, int voisinageVertical)
+    : tailleHorizontale_(tailleHorizontale), tailleVerticale_(tailleVerticale),
+    voisinageVertical_(voisinageVertical) {
+}
+
+uint64_t IndexSpatial::cle(int64_t ix, int64_t iy, int64_t iz) const {
+    const uint64_t masque = (1ULL << 21) - 1;
+    return ((static_cast<uint64_t>(ix) & masque) << 42)
+        | ((static_cast<uint64_t>(iy) & masque) << 21)
+        | (static_cast<uint64_t>(iz) & masque);
+}
+
+int64_t IndexSpatial::indiceHorizontal(double v) const {
+    return static_cast<int64_t>(std::floor(v / tailleHorizontale_));
+}
+
+int64_t IndexSpatial::indiceVertical(double v) const {
+    return static_cast<int64_t>(std::floor(v / tailleVerticale_));
+}
+
+void IndexSpatial::construire(const std::vector<Position>& positions) {
+    // On garde les cellules (et leur capacité) d'un appel à l'autre, sauf si la table a trop grossi
+    if (cellules_.size() > 4 * positions.size() + 64) {
+        cellules_.clear();
+    }
+    for (auto& [cleCellule, contenu] : cellules_) {
+        contenu.clear();
+    }
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const Position& p = positions[i];
+        cellules_[cle(indiceHorizontal(p.getX()), indiceHorizontal(p.getY()), indiceVertical(p.getAltitude()))].push_back(i);
+    }
+}
+
+void IndexSpatial::pairesCandidates(const std::vector<Position>& positions, std::vector<PaireConflit>& candidates) const {
+    candidates.clear();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const Position& p = positions[i];
+        int64_t ix = indiceHorizontal(p.getX());
+        int64_t iy = indiceHorizontal(p.getY());
+        int64_t iz = indiceVertical(p.getAltitude());
+
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                for (int64_t dz = -voisinageVertical_; dz <= voisinageVertical_; ++dz) {
+                    auto it = cellules_.find(cle(ix + dx, iy + dy, iz + dz));
+                    if (it == cellules_.end()) continue;
+                    for (size_t j : it->second) {
+                        if (j > i) candidates.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+}
+
+void IndexSpatial::detecterConflits(const std::vector<Position>& positions, std::vector<PaireConflit>& conflits) const {
+    pairesCandidates(positions, conflits);
+    conflits.erase(std::remove_if(conflits.begin(), conflits.end(), [&](const PaireConflit& paire) {
+        return !enConflit(positions[paire.first], positions[paire.second]);
+    }), conflits.end());
+}
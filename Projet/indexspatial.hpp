@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include "avion.hpp"
+
+// Seuils de séparation appliqués par la CCR
+constexpr double SEPARATION_HORIZONTALE = 20000.0;
+constexpr double SEPARATION_VERTICALE = 1000.0;
+
+using PaireConflit = std::pair<size_t, size_t>;
+
+// Deux positions sont en conflit si l'écart vertical est < SEPARATION_VERTICALE
+// et la distance < SEPARATION_HORIZONTALE
+bool enConflit(const Position& a, const Position& b);
+
+// Référence O(n²) : toutes les paires (i < j) en conflit, dans l'ordre lexicographique
+void detecterConflitsForceBrute(const std::vector<Position>& positions, std::vector<PaireConflit>& conflits);
+
+// Rapprochements à évaluer, en structure de tableaux : pour chaque paire (i, j), position et
+// vitesse (par pas) de j relativement à i, et nombre de pas pendant lesquels ce mouvement
+// rectiligne reste valable (fin de la branche en cours ou horizon)
+struct LotRapprochements {
+    std::vector<double> dx, dy, dz;
+    std::vector<double> vx, vy, vz;
+    std::vector<double> duree;
+    // Résultat : premier et dernier pas de perte de séparation, debut < 0 si aucune
+    std::vector<double> debut, fin;
+
+    void vider();
+    void ajouter(double dx, double dy, double dz, double vx, double vy, double vz, double duree);
+    size_t taille() const;
+};
+
+// Perte de séparation sur [0, duree] d'un mouvement relatif rectiligne : intersection de
+// l'intervalle où la distance horizontale est < SEPARATION_HORIZONTALE (point de plus proche
+// approche) et de celui où l'écart vertical est < SEPARATION_VERTICALE. debut < 0 si vide.
+void intervalleConflit(double dx, double dy, double dz, double vx, double vy, double vz, double duree,
+    double& debut, double& fin);
+
+// Tout le lot en une boucle sans branchement sur les tableaux, vectorisable
+void predireConflits(LotRapprochements& lot);
+
+// Grille uniforme hachée dont les cellules font la taille des seuils de séparation :
+// seules les cellules voisines sont comparées.
+class IndexSpatial {
+private:
+    double tailleHorizontale_;
+    double tailleVerticale_;
+    int voisinageVertical_;
+    std::unordered_map<uint64_t, std::vector<size_t>> cellules_;
+
+    uint64_t cle(int64_t ix, int64_t iy, int64_t iz) const;
+    int64_t indiceHorizontal(double v) const;
+    int64_t indiceVertical(double v) const;
+
+public:
+    // voisinageVertical : nombre de couches de cellules examinées au-dessus et en dessous
+    IndexSpatial(double tailleHorizontale = SEPARATION_HORIZONTALE,
+        double tailleVerticale = SEPARATION_VERTICALE, int voisinageVertical = 1);
+
+    void construire(const std::vector<Position>& positions);
+
+    // Paires (i < j) en conflit parmi les positions indexées, dans l'ordre lexicographique
+    void detecterConflits(const std::vector<Position>& positions, std::vector<PaireConflit>& conflits) const;
+
+    // Paires candidates (même voisinage de cellules), sans test de distance
+    void pairesCandidates(const std::vector<Position>& positions, std::vector<PaireConflit>& candidates) const;
+};
@@ -0,0 +1,21 @@
+#include "instantane.hpp"
+
+PublicateurInstantane::PublicateurInstantane() : milieu_(1), arriere_(0), avant_(2) {
+}
+
+std::vector<EnregistrementRendu>& PublicateurInstantane::tamponArriere() {
+    return tampons_[arriere_];
+}
+
+void PublicateurInstantane::publier() {
+    int ancien = milieu_.exchange(arriere_ | BIT_NOUVEAU, std::memory_order_acq_rel);
+    arriere_ = ancien & ~BIT_NOUVEAU;
+}
+
+const std::vector<EnregistrementRendu>& PublicateurInstantane::lire() {
+    if (milieu_.load(std::memory_order_relaxed) & BIT_NOUVEAU) {
+        int ancien = milieu_.exchange(avant_, std::memory_order_acq_rel);
+        avant_ = ancien & ~BIT_NOUVEAU;
+    }
+    return tampons_[avant_];
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "avion.hpp"
+
+// Ce dont le visualiseur a besoin pour un avion, relevé en une seule prise de verrou
+struct EnregistrementRendu {
+    uint32_t id;
+    float x, y, altitude;
+    float carburant;
+    float vitesse;
+    float vitesseSol;
+    EtatAvion etat;
+    TypeUrgence urgence;
+    char nom[16];
+    char destination[24];
+};
+
+// Publication de l'état du monde entre la simulation (un seul écrivain) et le rendu (un seul lecteur).
+// L'écrivain remplit son tampon arrière puis l'échange atomiquement avec le tampon "milieu" ;
+// le lecteur récupère le milieu s'il est plus récent que son tampon avant. Le troisième tampon
+// évite à l'écrivain de réécrire une image en cours de dessin, sans verrou d'un côté ni de l'autre.
+class PublicateurInstantane {
+private:
+    static constexpr int BIT_NOUVEAU = 4;
+
+    std::vector<EnregistrementRendu> tampons_[3];
+    std::atomic<int> milieu_;   // indice du tampon milieu, plus BIT_NOUVEAU s'il n'a pas été lu
+    int arriere_;
+    int avant_;
+
+public:
+    PublicateurInstantane();
+
+    // Côté simulation
+    std::vector<EnregistrementRendu>& tamponArriere();
+    void publier();
+
+    // Côté rendu : dernière image publiée (reste valide jusqu'au prochain appel)
+    const std::vector<EnregistrementRendu>& lire();
+};
@@ -0,0 +1,159 @@
+#include "journal.hpp"
+#include "avion.hpp"
+
+static const std::string NOM_INCONNU = "?";
+
+void TableNoms::nommerAvion(uint32_t id, const std::string& nom) {
+    auto it = avions_.find(id);
+    if (it != avions_.end()) {
+        it->second = nom;
+        return;
+    }
+    if (nomsLibres_.empty()) {
+        avions_.emplace(id, nom);
+        return;
+    }
+
+    // La chaîne du noeud garde sa capacité : le nom est recopié sans allocation
+    auto noeud = std::move(nomsLibres_.back());
+    nomsLibres_.pop_back();
+    noeud.key() = id;
+    noeud.mapped() = nom;
+    avions_.insert(std::move(noeud));
+}
+
+void TableNoms::oublierAvion(uint32_t id) {
+    auto noeud = avions_.extract(id);
+    if (!noeud.empty()) nomsLibres_.push_back(std::move(noeud));
+}
+
+void TableNoms::definirSymbole(uint32_t id, const std::string& texte) {
+    symboles_[id] = texte;
+    indexSymboles_[texte] = id;
+}
+
+uint32_t TableNoms::symbole(const std::string& texte) {
+    auto it = indexSymboles_.find(texte);
+    if (it != indexSymboles_.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(symboles_.size());
+    definirSymbole(id, texte);
+    return id;
+}
+
+const std::string& TableNoms::nomAvion(uint32_t id) const {
+    auto it = avions_.find(id);
+    return (it != avions_.end()) ? it->second : NOM_INCONNU;
+}
+
+const std::string& TableNoms::texteSymbole(uint32_t id) const {
+    auto it = symboles_.find(id);
+    return (it != symboles_.end()) ? it->second : NOM_INCONNU;
+}
+
+const char* nomActeur(ActeurLog acteur) {
+    switch (acteur) {
+    case ActeurLog::CCR: return "CCR";
+    case ActeurLog::APP: return "APP";
+    case ActeurLog::TWR: return "TWR";
+    case ActeurLog::AVION: return "AVION";
+    case ActeurLog::MAINTENANCE: return "MAINTENANCE";
+    }
+    return "INCONNU";
+}
+
+const char* nomAction(ActionLog action) {
+    switch (action) {
+    case ActionLog::PRISE_EN_CHARGE: return "Prise en charge";
+    case ActionLog::TRANSFERT_APP: return "Transfert vers APP";
+    case ActionLog::TRANSFERT_URGENCE_APP: return "Transfert d'urgence vers APP";
+    case ActionLog::COLLISION: return "Collision";
+    case ActionLog::MISE_EN_ATTENTE: return "Mise en attente (atterrissage refusé)";
+    case ActionLog::AUTORISATION_ATTERRISSAGE: return "Autorisation atterrissage";
+    case ActionLog::PARKING: return "Parking";
+    case ActionLog::DECOLLAGE: return "Decollage";
+    case ActionLog::CRASH: return "CRASH";
+    case ActionLog::URGENCE: return "URGENCE";
+    case ActionLog::REPARATION: return "Reparation";
+    case ActionLog::EVACUATION: return "Evacuation";
+    default: break;
+    }
+    return "INCONNUE";
+}
+
+// Même rendu que operator<<(Avion) : "[AF-1  Carburant : 5000]"
+static std::string descriptionAvion(const EvenementJournal& e, const TableNoms& noms) {
+    std::stringstream ss;
+    ss << "[" << noms.nomAvion(e.idAvion) << "  Carburant : " << (int)e.valeurs[0] << "]";
+    return ss.str();
+}
+
+std::string formaterDetails(const EvenementJournal& e, const TableNoms& noms) {
+    std::stringstream ss;
+    const std::string& nom = noms.nomAvion(e.idAvion);
+
+    switch (e.action) {
+    case ActionLog::PRISE_EN_CHARGE:
+        if (e.acteur == ActeurLog::CCR) {
+            ss << "Avion " << descriptionAvion(e, noms) << " pris en charge par la CCR, en destination de " << noms.texteSymbole(e.reference);
+        }
+        else {
+            ss << "L'avion " << descriptionAvion(e, noms) << " est pris en charge par l'APP";
+        }
+        break;
+    case ActionLog::TRANSFERT_APP:
+        ss << "Transfert de " << descriptionAvion(e, noms) << " vers l'APP";
+        break;
+    case ActionLog::TRANSFERT_URGENCE_APP:
+        ss << "Transfert prioritaire (urgence) de " << descriptionAvion(e, noms) << " vers APP";
+        break;
+    case ActionLog::COLLISION:
+        ss << "Séparation des avions pour éviter une collision : " << nom << " - " << noms.nomAvion(e.reference);
+        break;
+    case ActionLog::MISE_EN_ATTENTE:
+        ss << "Avion " << nom << " est en attente d'atterrissage.";
+        break;
+    case ActionLog::AUTORISATION_ATTERRISSAGE:
+        ss << "Autorisation d'atterrir pour " << descriptionAvion(e, noms);
+        break;
+    case ActionLog::PARKING:
+        ss << descriptionAvion(e, noms) << " bloque au bloc " << noms.texteSymbole(e.reference);
+        break;
+    case ActionLog::DECOLLAGE:
+        ss << "Decollage immediat piste " << (int)e.valeurs[1] << " pour " << descriptionAvion(e, noms);
+        break;
+    case ActionLog::CRASH:
+        ss << "Avion " << nom << " crashé par manque de carburant.";
+        break;
+    case ActionLog::URGENCE: {
+        std::string raison;
+        switch (static_cast<TypeUrgence>(e.reference)) {
+        case TypeUrgence::PANNE_MOTEUR: raison = "PANNE MOTEUR"; break;
+        case TypeUrgence::MEDICAL: raison = "MEDICALE (Passager)"; break;
+        case TypeUrgence::CARBURANT: raison = "CARBURANT"; break;
+        default: raison = "INCONNUE"; break;
+        }
+        ss << "Urgence déclarée : " << raison << " - Position " << Position(e.valeurs[0], e.valeurs[1], e.valeurs[2]);
+        break;
+    }
+    case ActionLog::REPARATION:
+        ss << "Moteur en cours de reparation sur " << nom;
+        break;
+    case ActionLog::EVACUATION:
+        ss << "Passager malade debarque de " << nom;
+        break;
+    default:
+        break;
+    }
+    return ss.str();
+}
+
+void ecrireEntreeJSON(std::ostream& os, bool premier, const std::string& acteur,
+    const std::string& action, const std::string& details) {
+    if (!premier) os << ",\n";
+    os << "  {\n";
+    os << "    \"Controleur\": \"" << acteur << "\",\n";
+    os << "    \"Action\": \"" << action << "\",\n";
+    os << "    \"Details\": \"" << details << "\"\n";
+    os << "  }";
+}
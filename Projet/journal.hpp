@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ostream>
+
+// Format des événements du journal, partagé par Logger et le convertisseur binaire -> JSON.
+
+enum class FormatJournal {
+    JSON,     // img/logs.json, lisible directement
+    BINAIRE   // img/logs.bin, enregistrements de 32 octets (voir ConvertisseurJournal)
+};
+
+enum class ActeurLog : uint8_t {
+    CCR,
+    APP,
+    TWR,
+    AVION,
+    MAINTENANCE
+};
+
+enum class ActionLog : uint8_t {
+    PRISE_EN_CHARGE,
+    TRANSFERT_APP,
+    TRANSFERT_URGENCE_APP,
+    COLLISION,
+    MISE_EN_ATTENTE,
+    AUTORISATION_ATTERRISSAGE,
+    PARKING,
+    DECOLLAGE,
+    CRASH,
+    URGENCE,
+    REPARATION,
+    EVACUATION,
+
+    // Enregistrements de définition (fichier binaire uniquement) : suivis de `reference` octets de nom
+    DEFINITION_AVION = 0xF0,
+    DEFINITION_SYMBOLE = 0xF1,
+
+    // Interne au Logger, jamais écrit : le nom de idAvion est oublié, après les événements déjà déposés
+    OUBLI_AVION = 0xF2
+};
+
+// Enregistrement binaire de taille fixe, écrit tel quel (petit-boutiste) dans logs.bin.
+// Signification de reference et valeurs[] selon l'action :
+//   PRISE_EN_CHARGE (CCR)    reference = symbole destination, valeurs[0] = carburant
+//   PRISE_EN_CHARGE (APP), TRANSFERT_*, AUTORISATION_ATTERRISSAGE : valeurs[0] = carburant
+//   COLLISION                reference = id du second avion
+//   PARKING                  reference = symbole du parking, valeurs[0] = carburant
+//   DECOLLAGE                valeurs[0] = carburant, valeurs[1] = X de la piste
+//   URGENCE                  reference = TypeUrgence, valeurs[] = position (x, y, altitude)
+struct EvenementJournal {
+    uint64_t tempsMs;
+    uint32_t idAvion;
+    ActeurLog acteur;
+    ActionLog action;
+    uint16_t reserve;
+    uint32_t reference;
+    float valeurs[3];
+};
+static_assert(sizeof(EvenementJournal) == 32, "EvenementJournal doit rester sur 32 octets");
+
+constexpr char SIGNATURE_JOURNAL[4] = { 'A', 'T', 'C', 'J' };
+constexpr uint32_t VERSION_JOURNAL = 1;
+// Longueur maximale d'un nom dans un enregistrement de définition (tronqué au-delà à l'écriture) :
+// à la lecture, une longueur plus grande signale un journal corrompu
+constexpr uint32_t LONGUEUR_NOM_MAX = 1024;
+
+// Noms des avions (par id) et des chaînes référencées par les événements (symboles)
+class TableNoms {
+private:
+    std::unordered_map<uint32_t, std::string> avions_;
+    // Noeuds des avions oubliés, repris par nommerAvion : en régime établi, nommer n'alloue plus
+    std::vector<std::unordered_map<uint32_t, std::string>::node_type> nomsLibres_;
+    std::unordered_map<uint32_t, std::string> symboles_;
+    std::unordered_map<std::string, uint32_t> indexSymboles_;
+
+public:
+    void nommerAvion(uint32_t id, const std::string& nom);
+    void oublierAvion(uint32_t id);
+    void definirSymbole(uint32_t id, const std::string& texte);
+    uint32_t symbole(const std::string& texte);
+
+    const std::string& nomAvion(uint32_t id) const;
+    const std::string& texteSymbole(uint32_t id) const;
+};
+
+const char* nomActeur(ActeurLog acteur);
+const char* nomAction(ActionLog action);
+std::string formaterDetails(const EvenementJournal& evenement, const TableNoms& noms);
+
+// Écrit une entrée au format historique de logs.json
+void ecrireEntreeJSON(std::ostream& os, bool premier, const std::string& acteur,
+    const std::string& action, const std::string& details);
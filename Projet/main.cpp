@@ -17,6 +17,8 @@
 
 #include "avion.hpp"
 #include "thread.hpp"
+#include "scenario.hpp"
+#include "instantane.hpp"
 
 // ================= CONSTANTES VISUELLES =================
 
@@ -53,17 +55,101 @@ void adapterFondFenetre(sf::Sprite& sprite, const sf::Texture& texture) {
     }
 }
 
-// ================= GLOBALES =================
-std::vector<std::thread> threads_infra;
-std::vector<Avion*> flotte;
-std::mutex mutexFlotte;
+// ================= GEOMETRIE PAR LOTS =================
+// Tout ce qui se répète (avions, aéroports, zones) est regroupé dans quelques sf::VertexArray
+// pour n'émettre qu'un appel de dessin par lot au lieu d'un par forme.
+
+// Cosinus/sinus précalculés d'un cercle découpé en nbSegments
+struct GabaritCercle {
+    std::vector<sf::Vector2f> directions;
+
+    explicit GabaritCercle(int nbSegments) {
+        directions.reserve(nbSegments + 1);
+        for (int i = 0; i <= nbSegments; ++i) {
+            float angle = 2.f * PI * i / nbSegments;
+            directions.push_back({ std::cos(angle), std::sin(angle) });
+        }
+    }
+};
+
+const GabaritCercle CERCLE_AVION(12);
+const GabaritCercle CERCLE_ZONE(64);
+
+// Disque plein en triangles (lot de type sf::PrimitiveType::Triangles)
+void ajouterDisque(sf::VertexArray& lot, const GabaritCercle& gabarit, sf::Vector2f centre, float rayon, sf::Color couleur) {
+    for (size_t i = 0; i + 1 < gabarit.directions.size(); ++i) {
+        lot.append(sf::Vertex{ centre, couleur });
+        lot.append(sf::Vertex{ centre + gabarit.directions[i] * rayon, couleur });
+        lot.append(sf::Vertex{ centre + gabarit.directions[i + 1] * rayon, couleur });
+    }
+}
+
+// Anneau (contour) en triangles, à l'extérieur du rayon donné comme setOutlineThickness
+void ajouterAnneau(sf::VertexArray& lot, const GabaritCercle& gabarit, sf::Vector2f centre, float rayon, float epaisseur, sf::Color couleur) {
+    float rayonExterieur = rayon + epaisseur;
+    for (size_t i = 0; i + 1 < gabarit.directions.size(); ++i) {
+        sf::Vector2f a = centre + gabarit.directions[i] * rayon;
+        sf::Vector2f b = centre + gabarit.directions[i + 1] * rayon;
+        sf::Vector2f c = centre + gabarit.directions[i] * rayonExterieur;
+        sf::Vector2f d = centre + gabarit.directions[i + 1] * rayonExterieur;
+        lot.append(sf::Vertex{ a, couleur });
+        lot.append(sf::Vertex{ c, couleur });
+        lot.append(sf::Vertex{ b, couleur });
+        lot.append(sf::Vertex{ b, couleur });
+        lot.append(sf::Vertex{ c, couleur });
+        lot.append(sf::Vertex{ d, couleur });
+    }
+}
+
+// La couleur code l'état : rouge = urgence, vert = sélectionné, gris = au parking, cyan = en mouvement
+sf::Color couleurAvion(const EnregistrementRendu& avion, uint32_t idSelectionne) {
+    if (avion.urgence != TypeUrgence::AUCUNE) return sf::Color::Red;
+    if (avion.id == idSelectionne) return sf::Color::Green;
+    if (avion.etat == EtatAvion::STATIONNE) return sf::Color(100, 100, 100);
+    return sf::Color::Cyan;
+}
 
-Avion* avionSelectionne = nullptr;
+// Géométrie statique des aéroports, construite une seule fois
+struct CarteAeroports {
+    sf::VertexArray zones{ sf::PrimitiveType::Triangles };
+    sf::VertexArray contours{ sf::PrimitiveType::Triangles };
+    sf::VertexArray points{ sf::PrimitiveType::Triangles };
+    std::vector<sf::Text> etiquettes;
+
+    CarteAeroports(const std::vector<Aeroport*>& aeroports, const sf::Font* font) {
+        for (auto aero : aeroports) {
+            sf::Vector2f p = worldToScreen(aero->position);
+            float rayonVisuel = aero->rayonControle * ECHELLE;
+
+            ajouterDisque(zones, CERCLE_ZONE, p, rayonVisuel, sf::Color(255, 0, 0, 30));
+            ajouterAnneau(contours, CERCLE_ZONE, p, rayonVisuel, 1.f, sf::Color::Red);
+            ajouterDisque(points, CERCLE_AVION, p, 5.f, sf::Color::Red);
+
+            if (font != nullptr) {
+                sf::Text text(*font, aero->nom, 12);
+                // CORRECTION SFML 3 : setPosition({x, y})
+                text.setPosition({ p.x + 10.f, p.y - 10.f });
+                text.setFillColor(sf::Color::White);
+                etiquettes.push_back(text);
+            }
+        }
+    }
+
+    void dessiner(sf::RenderWindow& window) const {
+        window.draw(zones);
+        window.draw(contours);
+        window.draw(points);
+        for (const sf::Text& text : etiquettes) window.draw(text);
+    }
+};
+
+// ================= GLOBALES =================
+uint32_t idAvionSelectionne = 0; // 0 : aucun avion sélectionné
 Aeroport* aeroportVue = nullptr;
 
 // ================= MAIN =================
-int main() {
-    std::srand(static_cast<unsigned int>(time(NULL)));
+// Usage : Simulateur [fichier_scenario] (format dans descriptionscenario.hpp ; par défaut Paris, Lille, Marseille)
+int main(int argc, char* argv[]) {
 
     std::cout << "===============================================\n";
     std::cout << "   SIMULATEUR ATC - VISUALISATION SFML 3.0     \n";
@@ -96,67 +182,34 @@ int main() {
     }
 
     // --- 3. CREATION INFRASTRUCTURE ---
-    CCR ccr;
-    Aeroport cdg("Paris", Position(0, 0, 0), 80000.0f);
-    //Aeroport ory("ORY", Position(-5000, -35000, 0), 20000.0f);
-    Aeroport lil("Lille", Position(93000, 331000, 0), 80000.0f);
-    //Aeroport sxb("SXB", Position(550000, -30000, 0), 20000.0f);
-    //Aeroport lys("LYS", Position(345000, -540000, 0), 20000.0f);
-    //Aeroport nce("NCE", Position(675000, -900000, 0), 20000.0f);
-    Aeroport mrs("Marseille", Position(432000, -785000, 0), 80000.0f);
-    //Aeroport tls("TLS", Position(-60000, -810000, 0), 20000.0f);
-    //Aeroport bod("BOD", Position(-300000, -675000, 0), 20000.0f);
-    //Aeroport nte("NTE", Position(-390000, -345000, 0), 20000.0f);
-    //Aeroport bes("BES", Position(-750000, -120000, 0), 20000.0f);
-
-    //std::vector<Aeroport*> listeAeroports = { &cdg, &ory, &lil, &sxb, &lys, &nce, &mrs, &tls, &bod, &nte, &bes };
-    std::vector<Aeroport*> listeAeroports = { &cdg, &lil, &mrs };
-
-    // --- 4. THREADS INFRA ---
-    threads_infra.emplace_back(routine_ccr, std::ref(ccr));
-    for (Aeroport* aero : listeAeroports) {
-        threads_infra.emplace_back(routine_twr, std::ref(*aero->twr));
-        threads_infra.emplace_back(routine_app, std::ref(*aero->app));
+    DescriptionScenario description = DescriptionScenario::parDefaut();
+    if (argc > 1) {
+        std::string erreur;
+        if (!chargerScenario(argv[1], description, erreur)) {
+            std::cerr << "[ERREUR] " << argv[1] << " : " << erreur << "\n";
+            return 1;
+        }
     }
+    Scenario scenario(description);
+    std::vector<Aeroport*>& listeAeroports = scenario.aeroports;
 
-    // --- 5. GENERATEUR TRAFIC ---
-    std::thread trafficGenerator([&]() {
-        int idAvion = 1;
-        for (int i = 0; i < 5; ++i) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-
-            std::string nom = "AF-" + std::to_string(idAvion++);
-            int idxDepart = std::rand() % listeAeroports.size();
-            int idxDest;
-            do { idxDest = std::rand() % listeAeroports.size(); } while (idxDest == idxDepart);
-
-            Aeroport* depart = listeAeroports[idxDepart];
-            Aeroport* destination = listeAeroports[idxDest];
-
-            Position posDepart = depart->position;
-            posDepart.setPosition(posDepart.getX(), posDepart.getY() - 5000, 10000);
-
-            Avion* nouvelAvion = new Avion(nom, 4000.f, 5.f, 5000.f, 10.f, 5000.f, posDepart);
-            nouvelAvion->setDestination(destination);
-
-            ccr.prendreEnCharge(nouvelAvion);
+    // --- 4. THREADS INFRA ---
+    // Le rendu ne lit que l'instantané publié : aucun verrou d'Avion ni de la flotte
+    scenario.activerInstantanes();
+    scenario.demarrerControleurs();
 
-            std::thread tPilote(routine_avion,
-                std::ref(*nouvelAvion), std::ref(*depart), std::ref(*destination),
-                std::ref(ccr), listeAeroports
-            );
-            tPilote.detach();
+    const CarteAeroports carteAeroports(listeAeroports, hasFont ? &font : nullptr);
+    // Réutilisés d'une image à l'autre : clear() garde la capacité déjà allouée
+    sf::VertexArray lotAvions(sf::PrimitiveType::Triangles);
+    sf::VertexArray lotContoursUrgence(sf::PrimitiveType::Triangles);
 
-            {
-                std::lock_guard<std::mutex> lock(mutexFlotte);
-                flotte.push_back(nouvelAvion);
-            }
-        }
-        });
-    trafficGenerator.detach();
+    // --- 5. GENERATEUR TRAFIC ---
+    scenario.genererTrafic(5, 1000);
 
     // --- 6. BOUCLE D'AFFICHAGE ---
     while (window.isOpen()) {
+        const std::vector<EnregistrementRendu>& instantane = scenario.instantane.lire();
+
         while (const std::optional event = window.pollEvent()) {
             if (event->is<sf::Event::Closed>()) {
                 window.close();
@@ -171,27 +224,23 @@ int main() {
                     sf::Vector2f mousePos = window.mapPixelToCoords(mouseBtn->position);
 
                     bool clicSurAvion = false;
-                    {
-                        std::lock_guard<std::mutex> lock(mutexFlotte);
-                        for (auto avion : flotte) {
-                            if (avion == nullptr || avion->getEtat() == EtatAvion::TERMINE) continue;
-                            sf::Vector2f posAvion = worldToScreen(avion->getPosition());
-
-                            // Distance de clic
-                            float dx = mousePos.x - posAvion.x;
-                            float dy = mousePos.y - posAvion.y;
-                            float dist = std::sqrt(dx * dx + dy * dy);
-
-                            if (dist < (30.0f * niveauZoomActuel)) {
-                                avionSelectionne = avion;
-                                clicSurAvion = true;
-                                break;
-                            }
+                    for (const EnregistrementRendu& avion : instantane) {
+                        sf::Vector2f posAvion = worldToScreen(Position(avion.x, avion.y, avion.altitude));
+
+                        // Distance de clic
+                        float dx = mousePos.x - posAvion.x;
+                        float dy = mousePos.y - posAvion.y;
+                        float dist = std::sqrt(dx * dx + dy * dy);
+
+                        if (dist < (30.0f * niveauZoomActuel)) {
+                            idAvionSelectionne = avion.id;
+                            clicSurAvion = true;
+                            break;
                         }
                     }
 
                     if (!clicSurAvion) {
-                        avionSelectionne = nullptr;
+                        idAvionSelectionne = 0;
                         if (aeroportVue != nullptr) {
                             aeroportVue = nullptr;
                             vueMonde = window.getDefaultView();
@@ -236,155 +285,106 @@ int main() {
 
         // Dessin Aéroports
         if (aeroportVue == nullptr) {
-            for (auto aero : listeAeroports) {
-                sf::Vector2f p = worldToScreen(aero->position);
-
-                sf::CircleShape point(5.f);
-                point.setFillColor(sf::Color::Red);
-                point.setOrigin({ 5.f, 5.f }); // Accolades
-                point.setPosition(p);
-                window.draw(point);
-                float rayonVisuel = aero->rayonControle * ECHELLE;
-                sf::CircleShape zone(rayonVisuel);
-                zone.setFillColor(sf::Color(255, 0, 0, 30));
-                zone.setOutlineColor(sf::Color::Red);
-                zone.setOutlineThickness(1.f);
-                zone.setOrigin({ rayonVisuel, rayonVisuel });
-                zone.setPosition(p);
-                window.draw(zone);
-
-                if (hasFont) {
-                    sf::Text text(font, aero->nom, 12);
-                    // CORRECTION SFML 3 : setPosition({x, y})
-                    text.setPosition({ p.x + 10.f, p.y - 10.f });
-                    text.setFillColor(sf::Color::White);
-                    window.draw(text);
-                }
-            }
+            carteAeroports.dessiner(window);
         }
 
-        // Dessin Avions
-        {
-            std::lock_guard<std::mutex> lock(mutexFlotte);
-            for (auto avion : flotte) {
-                if (avion == nullptr) continue;
-                if (avion->getEtat() == EtatAvion::TERMINE) continue;
-
-                sf::Vector2f screenPos = worldToScreen(avion->getPosition());
-                float rayonBase = (aeroportVue == nullptr) ? 6.f : 15.f;
-
-                sf::CircleShape dot(rayonBase);
-                dot.setOrigin({ rayonBase, rayonBase }); // Accolades
-                dot.setPosition(screenPos);
-                dot.setScale({ niveauZoomActuel, niveauZoomActuel }); // Accolades
-
-                if (avion->estEnUrgence()) {
-                    dot.setFillColor(sf::Color::Red);
-                    dot.setOutlineColor(sf::Color::Yellow);
-                    dot.setOutlineThickness(2.f);
-                }
-                else if (avion == avionSelectionne) {
-                    dot.setFillColor(sf::Color::Green);
+        // Dessin Avions : un lot pour les disques, un pour les contours d'urgence
+        lotAvions.clear();
+        lotContoursUrgence.clear();
+        float rayonAvion = ((aeroportVue == nullptr) ? 6.f : 15.f) * niveauZoomActuel;
+        const EnregistrementRendu* avionSelectionne = nullptr;
+
+        for (const EnregistrementRendu& avion : instantane) {
+            sf::Vector2f screenPos = worldToScreen(Position(avion.x, avion.y, avion.altitude));
+            ajouterDisque(lotAvions, CERCLE_AVION, screenPos, rayonAvion, couleurAvion(avion, idAvionSelectionne));
+            if (avion.urgence != TypeUrgence::AUCUNE) {
+                ajouterAnneau(lotContoursUrgence, CERCLE_AVION, screenPos, rayonAvion, 2.f * niveauZoomActuel, sf::Color::Yellow);
+            }
+            if (avion.id == idAvionSelectionne) avionSelectionne = &avion;
+        }
+        window.draw(lotAvions);
+        window.draw(lotContoursUrgence);
+
+        if (avionSelectionne != nullptr) {
+            const EnregistrementRendu& avion = *avionSelectionne;
+            sf::Vector2f screenPos = worldToScreen(Position(avion.x, avion.y, avion.altitude));
+            bool enUrgence = avion.urgence != TypeUrgence::AUCUNE;
+
+            // Info Bulle
+            if (hasFont) {
+                sf::Vector2f tailleBox = { 240.f, 140.f };
+                sf::RectangleShape infoBox(tailleBox);
+                infoBox.setFillColor(sf::Color(0, 0, 0, 200));
+                infoBox.setOutlineColor(sf::Color::White);
+                infoBox.setOutlineThickness(1.f);
+                infoBox.setScale({ niveauZoomActuel, niveauZoomActuel });
+
+                sf::Vector2f offset = { 20.f * niveauZoomActuel, -60.f * niveauZoomActuel };
+                sf::Vector2f boxPos = screenPos + offset;
+                infoBox.setPosition(boxPos);
+                window.draw(infoBox);
+
+                std::stringstream ss; 
+                ss << "VOL: " << avion.nom << "\n";
+                ss << "Dest: " << avion.destination << "\n";                    
+                ss << "Alt: " << (int)avion.altitude << " m\n";
+                ss << "Fuel: " << (int)avion.carburant << " L\n";
+                float vitesseAffichee = 0.f;
+                EtatAvion etat = avion.etat;
+                if (etat == EtatAvion::STATIONNE || etat == EtatAvion::EN_ATTENTE_DECOLLAGE ||
+                    etat == EtatAvion::EN_ATTENTE_PISTE || etat == EtatAvion::EN_ATTENTE_ATTERRISSAGE) {
+                    vitesseAffichee = 0.f;
                 }
-                else if (avion->getEtat() == EtatAvion::STATIONNE) {
-                    dot.setFillColor(sf::Color(100, 100, 100));
+                else if (etat == EtatAvion::ROULE_VERS_PISTE || etat == EtatAvion::ROULE_VERS_PARKING) {
+                    vitesseAffichee = avion.vitesseSol;
                 }
                 else {
-                    dot.setFillColor(sf::Color::Cyan);
+                    vitesseAffichee = avion.vitesse / 2.f;
                 }
 
-                window.draw(dot);
-
-                // Info Bulle
-                if (avion == avionSelectionne && hasFont) {
-                    sf::Vector2f tailleBox = { 240.f, 140.f };
-                    sf::RectangleShape infoBox(tailleBox);
-                    infoBox.setFillColor(sf::Color(0, 0, 0, 200));
-                    infoBox.setOutlineColor(sf::Color::White);
-                    infoBox.setOutlineThickness(1.f);
-                    infoBox.setScale({ niveauZoomActuel, niveauZoomActuel });
-
-                    sf::Vector2f offset = { 20.f * niveauZoomActuel, -60.f * niveauZoomActuel };
-                    sf::Vector2f boxPos = screenPos + offset;
-                    infoBox.setPosition(boxPos);
-                    window.draw(infoBox);
-
-                    std::stringstream ss; 
-                    ss << "VOL: " << avion->getNom() << "\n";
-                    Aeroport* dest = avion->getDestination();
-                    ss << "Dest: " << (dest ? dest->nom : "N/A") << "\n";                    
-                    ss << "Alt: " << (int)avion->getPosition().getAltitude() << " m\n";
-                    ss << "Fuel: " << (int)avion->getCarburant() << " L\n";
-                    float vitesseAffichee = 0.f;
-                    EtatAvion etat = avion->getEtat();
-                    if (etat == EtatAvion::STATIONNE || etat == EtatAvion::EN_ATTENTE_DECOLLAGE ||
-                        etat == EtatAvion::EN_ATTENTE_PISTE || etat == EtatAvion::EN_ATTENTE_ATTERRISSAGE) {
-                        vitesseAffichee = 0.f;
+                ss << "Vit: " << (int)vitesseAffichee << " km/h\n";
+                if (enUrgence) {
+                    if (avion.urgence == TypeUrgence::PANNE_MOTEUR) {
+                        ss << "Urgence de type : Panne moteur\n";
                     }
-                    else if (etat == EtatAvion::ROULE_VERS_PISTE || etat == EtatAvion::ROULE_VERS_PARKING) {
-                        vitesseAffichee = avion->getVitesseSol();
+                    else if (avion.urgence == TypeUrgence::CARBURANT) {
+                        ss << "Urgence de type : Carburant\n";
                     }
                     else {
-                        vitesseAffichee = avion->getVitesse() / 2.f;
+                        ss << "Urgence de type : Medicale\n";
                     }
-
-                    ss << "Vit: " << (int)vitesseAffichee << " km/h\n";
-                    if (avion->estEnUrgence()) {
-                        if (avion->getTypeUrgence() == TypeUrgence::PANNE_MOTEUR) {
-                            ss << "Urgence de type : Panne moteur\n";
-                        }
-                        else if (avion->getTypeUrgence() == TypeUrgence::CARBURANT) {
-                            ss << "Urgence de type : Carburant\n";
-                        }
-                        else {
-                            ss << "Urgence de type : Medicale\n";
-                        }
-                    }
-                    std::string etatStr = "INCONNU";
-                    switch (avion->getEtat()) {
-                    case EtatAvion::STATIONNE:              etatStr = "Stationne"; break;
-                    case EtatAvion::EN_ATTENTE_DECOLLAGE:   etatStr = "Attente Decollage"; break;
-                    case EtatAvion::ROULE_VERS_PISTE:       etatStr = "Roule vers la piste"; break;
-                    case EtatAvion::EN_ATTENTE_PISTE:       etatStr = "En attente au seuil de la piste"; break;
-                    case EtatAvion::DECOLLAGE:              etatStr = "Decollage"; break;
-                    case EtatAvion::EN_ROUTE:               etatStr = "En Croisiere"; break;
-                    case EtatAvion::EN_APPROCHE:            etatStr = "Approche"; break;
-                    case EtatAvion::EN_ATTENTE_ATTERRISSAGE:etatStr = "Circuit d'Attente"; break;
-                    case EtatAvion::ATTERRISSAGE:           etatStr = "Atterrissage"; break;
-                    case EtatAvion::ROULE_VERS_PARKING:     etatStr = "Taxi vers Parking"; break;
-                    case EtatAvion::TERMINE:                etatStr = "Termine"; break;
-                    }
-                    ss << "Etat: " << etatStr << "\n";
-                    sf::Text text(font, ss.str(), 14);
-                    text.setScale({ niveauZoomActuel, niveauZoomActuel });
-                    // CORRECTION SFML 3 : Opération dans les accolades
-                    text.setPosition({
-                        boxPos.x + 10.f * niveauZoomActuel,
-                        boxPos.y + 10.f * niveauZoomActuel
-                        });
-                    text.setFillColor(sf::Color::White);
-                    if (avion->estEnUrgence()) text.setFillColor(sf::Color::Red);
-
-                    window.draw(text);
                 }
+                std::string etatStr = "INCONNU";
+                switch (etat) {
+                case EtatAvion::STATIONNE:              etatStr = "Stationne"; break;
+                case EtatAvion::EN_ATTENTE_DECOLLAGE:   etatStr = "Attente Decollage"; break;
+                case EtatAvion::ROULE_VERS_PISTE:       etatStr = "Roule vers la piste"; break;
+                case EtatAvion::EN_ATTENTE_PISTE:       etatStr = "En attente au seuil de la piste"; break;
+                case EtatAvion::DECOLLAGE:              etatStr = "Decollage"; break;
+                case EtatAvion::EN_ROUTE:               etatStr = "En Croisiere"; break;
+                case EtatAvion::EN_APPROCHE:            etatStr = "Approche"; break;
+                case EtatAvion::EN_ATTENTE_ATTERRISSAGE:etatStr = "Circuit d'Attente"; break;
+                case EtatAvion::ATTERRISSAGE:           etatStr = "Atterrissage"; break;
+                case EtatAvion::ROULE_VERS_PARKING:     etatStr = "Taxi vers Parking"; break;
+                case EtatAvion::TERMINE:                etatStr = "Termine"; break;
+                }
+                ss << "Etat: " << etatStr << "\n";
+                sf::Text text(font, ss.str(), 14);
+                text.setScale({ niveauZoomActuel, niveauZoomActuel });
+                // CORRECTION SFML 3 : Opération dans les accolades
+                text.setPosition({
+                    boxPos.x + 10.f * niveauZoomActuel,
+                    boxPos.y + 10.f * niveauZoomActuel
+                    });
+                text.setFillColor(sf::Color::White);
+                if (enUrgence) text.setFillColor(sf::Color::Red);
+
+                window.draw(text);
             }
         }
         window.display();
     }
-    {
-        std::lock_guard<std::mutex> lock(mutexFlotte);
-
-        for (Avion* avion : flotte) {
-            if (avion != nullptr) {
-                // On passe l'état à TERMINE pour que le thread pilote s'arrête (si ce n'est pas déjà fait)
-                avion->setEtat(EtatAvion::TERMINE);
-
-                // On supprime l'objet en mémoire
-                delete avion;
-            }
-        }
-        // On vide le vecteur de pointeurs
-        flotte.clear();
-    }
+    // Arrêt des routines puis libération des avions (voir Scenario::arreter)
+    scenario.arreter();
     return 0;
 }
\ No newline at end of file
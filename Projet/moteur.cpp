@@ -0,0 +1,323 @@
+#include "moteur.hpp"
+#include "horloge.hpp"
+#include <limits>
+#include <algorithm>
+
+MoteurEvenements::MoteurEvenements(CCR& ccr, const std::vector<Aeroport*>& aeroports)
+    : ccr_(ccr), aeroports_(aeroports), sequence_(0),
+    maintenantMs_(HorlogeSimulation::getInstance().maintenantMs()),
+    twr_(aeroports.size()), app_(aeroports.size()), dernierePasseCCRMs_(maintenantMs_), sauts_(true), nbEvenements_(0), nbPasSautes_(0) {
+    // Le temps n'avance plus qu'au rythme des événements
+    HorlogeSimulation::getInstance().setFacteur(0);
+}
+
+MoteurEvenements::~MoteurEvenements() {
+    for (Aeroport* aero : aeroports_) {
+        aero->twr->getSignal().rediriger(nullptr);
+        aero->app->getSignal().rediriger(nullptr);
+    }
+}
+
+void MoteurEvenements::pousser(long long tempsMs, TypeEvenement type, uint32_t indice, uint32_t generation) {
+    file_.push({ tempsMs, sequence_++, type, indice, generation });
+}
+
+// Un seul passage en attente par contrôleur : le plus proche
+void MoteurEvenements::planifierControleur(EtatControleur& etat, TypeEvenement type, uint32_t indice, long long tempsMs) {
+    if (etat.prochainMs <= tempsMs) return;
+    etat.prochainMs = tempsMs;
+    pousser(tempsMs, type, indice, ++etat.generation);
+}
+
+// Prochaine passe sur la grille de routine_ccr, une toutes les PERIODE_CCR_MS depuis la
+// dernière : celle de l'instant courant s'il tombe sur la grille
+void MoteurEvenements::reveillerCCR() {
+    long long periodes = (maintenantMs_ - dernierePasseCCRMs_ + PERIODE_CCR_MS - 1) / PERIODE_CCR_MS;
+    long long grille = dernierePasseCCRMs_ + std::max<long long>(1, periodes) * PERIODE_CCR_MS;
+    planifierControleur(ccrEtat_, TypeEvenement::PASSE_CCR, 0, grille);
+}
+
+void MoteurEvenements::setSauts(bool actifs) {
+    sauts_ = actifs;
+}
+
+void MoteurEvenements::demarrer() {
+    for (uint32_t i = 0; i < aeroports_.size(); ++i) {
+        aeroports_[i]->twr->getSignal().rediriger([this, i]() {
+            planifierControleur(twr_[i], TypeEvenement::CONTROLEUR_TWR, i, maintenantMs_);
+        });
+        aeroports_[i]->app->getSignal().rediriger([this, i]() {
+            planifierControleur(app_[i], TypeEvenement::CONTROLEUR_APP, i, maintenantMs_);
+        });
+
+        // routine_twr commence par attendre, routine_app par un passage
+        twr_[i].prochainMs = std::numeric_limits<long long>::max();
+        planifierControleur(twr_[i], TypeEvenement::CONTROLEUR_TWR, i, maintenantMs_ + DELAI_SECURITE_CONTROLEUR_MS);
+        app_[i].prochainMs = std::numeric_limits<long long>::max();
+        planifierControleur(app_[i], TypeEvenement::CONTROLEUR_APP, i, maintenantMs_);
+    }
+    ccrEtat_.prochainMs = std::numeric_limits<long long>::max();
+    planifierControleur(ccrEtat_, TypeEvenement::PASSE_CCR, 0, maintenantMs_);
+}
+
+void MoteurEvenements::ajouterPilote(const PiloteAvion& pilote) {
+    EntreePilote entree;
+    entree.pilote = pilote;
+
+    // Entrée d'un pilote terminé reprise en priorité, sous une nouvelle génération : les
+    // événements de l'ancien pilote encore dans la file sont périmés
+    uint32_t indice;
+    if (!pilotesLibres_.empty()) {
+        indice = pilotesLibres_.back();
+        pilotesLibres_.pop_back();
+        entree.generation = pilotes_[indice].generation + 1;
+        pilotes_[indice] = entree;
+    }
+    else {
+        indice = static_cast<uint32_t>(pilotes_.size());
+        pilotes_.push_back(entree);
+    }
+    pousser(maintenantMs_, TypeEvenement::PAS_PILOTE, indice, entree.generation);
+    // Vol créé déjà pris en charge par la CCR : elle ne peut plus dormir
+    if (pilote.avion->getEtat() == EtatAvion::EN_ROUTE) reveillerCCR();
+}
+
+void MoteurEvenements::planifier(long long tempsMs, std::function<void()> action) {
+    uint32_t indice;
+    if (!actionsLibres_.empty()) {
+        indice = actionsLibres_.back();
+        actionsLibres_.pop_back();
+        actions_[indice] = std::move(action);
+    }
+    else {
+        indice = static_cast<uint32_t>(actions_.size());
+        actions_.push_back(std::move(action));
+    }
+    pousser(tempsMs, TypeEvenement::ACTION, indice, 0);
+}
+
+void MoteurEvenements::planifierPilote(size_t indice, int attenteMs) {
+    EntreePilote& entree = pilotes_[indice];
+    Avion& avion = *entree.pilote.avion;
+    EtatAvion etat = avion.getEtat();
+    ++entree.generation;
+    entree.enBloc = false;
+
+    int nbPas = 0;
+    bool attentePure = false;
+    if (sauts_ && entree.pilote.escale == PhaseEscale::AUCUNE) {
+        bool auSol = (etat == EtatAvion::ROULE_VERS_PISTE || etat == EtatAvion::ROULE_VERS_PARKING);
+        bool enVol = (etat == EtatAvion::DECOLLAGE || etat == EtatAvion::EN_ROUTE || etat == EtatAvion::EN_APPROCHE
+            || etat == EtatAvion::EN_ATTENTE_ATTERRISSAGE || etat == EtatAvion::ATTERRISSAGE);
+        bool decompte = (etat == EtatAvion::EN_ROUTE || etat == EtatAvion::EN_APPROCHE) && !avion.estEnUrgence();
+
+        if (attenteMs == PERIODE_PILOTE_MS && (auSol || enVol)) {
+            // Au-dessus de 2000 m, pas_avion passe l'avion en croisière
+            double plafond = (etat == EtatAvion::DECOLLAGE) ? 2000.0 : std::numeric_limits<double>::infinity();
+            nbPas = avion.pasSansEvenement(DT_PILOTE, auSol, plafond);
+            // Le bloc s'arrête avant le pas dont le tirage déclenche une urgence
+            if (decompte) nbPas = pasSansUrgence(entree.pilote.alea, nbPas);
+            entree.enMouvement = true;
+            entree.auSol = auSol;
+            entree.decompteUrgence = decompte;
+        }
+        else if ((attenteMs == PERIODE_PILOTE_MS && etat == EtatAvion::EN_ATTENTE_PISTE)
+            || etat == EtatAvion::EN_ATTENTE_DECOLLAGE) {
+            // Rien à faire avant que la TWR ne touche à l'avion
+            attentePure = true;
+            entree.enMouvement = false;
+            entree.decompteUrgence = false;
+        }
+    }
+
+    if (nbPas > 0 || attentePure) {
+        entree.enBloc = true;
+        entree.debutMs = maintenantMs_;
+        entree.periodeMs = attenteMs;
+        entree.pasBloc = attentePure ? std::numeric_limits<int>::max() : nbPas;
+        entree.pasAppliques = 0;
+        entree.version = avion.getVersion();
+        if (attentePure) return;
+        pousser(maintenantMs_ + static_cast<long long>(nbPas + 1) * attenteMs, TypeEvenement::PAS_PILOTE,
+            static_cast<uint32_t>(indice), entree.generation);
+        return;
+    }
+
+    pousser(maintenantMs_ + attenteMs, TypeEvenement::PAS_PILOTE, static_cast<uint32_t>(indice), entree.generation);
+}
+
+// Joue d'un coup les pas du bloc échus à l'instant courant
+void MoteurEvenements::synchroniser(EntreePilote& entree) {
+    if (!entree.enBloc || !entree.enMouvement) return;
+
+    long long echus = std::min<long long>(entree.pasBloc, (maintenantMs_ - entree.debutMs) / entree.periodeMs);
+    int nbPas = static_cast<int>(echus) - entree.pasAppliques;
+    if (nbPas <= 0) return;
+
+    entree.pilote.avion->avancerPas(nbPas, DT_PILOTE, entree.auSol);
+    // Tirages d'urgence des pas sautés, consommés comme pas à pas
+    if (entree.decompteUrgence) entree.pilote.alea.sauter(static_cast<size_t>(nbPas));
+    entree.pasAppliques += nbPas;
+    nbPasSautes_ += nbPas;
+}
+
+template <typename Predicat>
+void MoteurEvenements::preparerControleur(Predicat&& concerne) {
+    concernes_.clear();
+    for (size_t i = 0; i < pilotes_.size(); ++i) {
+        EntreePilote& entree = pilotes_[i];
+        if (entree.termine || !entree.enBloc || !concerne(entree.pilote)) continue;
+        synchroniser(entree);
+        concernes_.push_back(i);
+    }
+}
+
+void MoteurEvenements::verifierModifications() {
+    for (size_t i : concernes_) {
+        EntreePilote& entree = pilotes_[i];
+        if (!entree.enBloc || entree.pilote.avion->getVersion() == entree.version) continue;
+
+        // Reprise pas à pas au premier tick après le passage du contrôleur
+        entree.enBloc = false;
+        long long tick = entree.debutMs + static_cast<long long>(entree.pasAppliques + 1) * entree.periodeMs;
+        if (!entree.enMouvement) {
+            tick = entree.debutMs + ((maintenantMs_ - entree.debutMs) / entree.periodeMs + 1) * entree.periodeMs;
+        }
+        pousser(tick, TypeEvenement::PAS_PILOTE, static_cast<uint32_t>(i), ++entree.generation);
+    }
+}
+
+void MoteurEvenements::traiterPilote(size_t indice) {
+    EntreePilote& entree = pilotes_[indice];
+    Avion& avion = *entree.pilote.avion;
+
+    if (entree.enBloc) {
+        synchroniser(entree);
+        entree.enBloc = false;
+    }
+
+    EtatAvion etatAvant = avion.getEtat();
+    bool urgenceAvant = avion.estEnUrgence();
+    int attenteMs = pas_avion(entree.pilote);
+    EtatAvion etat = avion.getEtat();
+
+    if (etat == EtatAvion::TERMINE) {
+        entree.termine = true;
+        rendre_avion(entree.pilote);
+        pilotesLibres_.push_back(static_cast<uint32_t>(indice));
+        return;
+    }
+
+    // Nouvelle prise en charge ou urgence en croisière : la CCR ne peut plus dormir
+    if (etat == EtatAvion::EN_ROUTE && (etatAvant != EtatAvion::EN_ROUTE || (!urgenceAvant && avion.estEnUrgence()))) {
+        reveillerCCR();
+    }
+
+    planifierPilote(indice, attenteMs);
+}
+
+void MoteurEvenements::traiterCCR() {
+    preparerControleur([](const PiloteAvion& pilote) { return pilote.avion->getEtat() == EtatAvion::EN_ROUTE; });
+    ccr_.gererEspaceAerien();
+    dernierePasseCCRMs_ = maintenantMs_;
+    verifierModifications();
+
+    // Passes suivantes inutiles tant qu'aucun avion n'a pu parcourir pasSansIntervention pas.
+    // Un pilote fait au plus floor(d / PERIODE_PILOTE_MS) + 1 pas en d ms.
+    long long nbPas = sauts_ ? ccr_.pasSansIntervention(DT_PILOTE) : 0;
+    long long delai = std::max<long long>(PERIODE_CCR_MS,
+        (nbPas - 1) * PERIODE_PILOTE_MS / PERIODE_CCR_MS * PERIODE_CCR_MS);
+
+    ccrEtat_.prochainMs = std::numeric_limits<long long>::max();
+    planifierControleur(ccrEtat_, TypeEvenement::PASSE_CCR, 0, maintenantMs_ + delai);
+}
+
+void MoteurEvenements::traiter(const Evenement& evenement) {
+    switch (evenement.type) {
+    case TypeEvenement::PAS_PILOTE: {
+        EntreePilote& entree = pilotes_[evenement.indice];
+        if (entree.termine || evenement.generation != entree.generation) return;
+        traiterPilote(evenement.indice);
+        break;
+    }
+    case TypeEvenement::PASSE_CCR:
+        if (evenement.generation != ccrEtat_.generation) return;
+        traiterCCR();
+        break;
+    case TypeEvenement::CONTROLEUR_TWR: {
+        EtatControleur& etat = twr_[evenement.indice];
+        if (evenement.generation != etat.generation) return;
+        Aeroport* aero = aeroports_[evenement.indice];
+
+        // Prochain passage au plus tard après le délai de sécurité ; un signal émis pendant
+        // ce passage en replanifie un immédiatement, comme un signal reçu hors attente
+        etat.prochainMs = std::numeric_limits<long long>::max();
+        planifierControleur(etat, TypeEvenement::CONTROLEUR_TWR, evenement.indice, maintenantMs_ + DELAI_SECURITE_CONTROLEUR_MS);
+
+        preparerControleur([aero](const PiloteAvion& pilote) { return pilote.aeroDepart == aero || pilote.aeroArrivee == aero; });
+        pas_twr(*aero->twr);
+        verifierModifications();
+        planifierControleur(etat, TypeEvenement::CONTROLEUR_TWR, evenement.indice,
+            maintenantMs_ + aero->twr->delaiReveil(DELAI_SECURITE_CONTROLEUR_MS));
+        break;
+    }
+    case TypeEvenement::CONTROLEUR_APP: {
+        EtatControleur& etat = app_[evenement.indice];
+        if (evenement.generation != etat.generation) return;
+        Aeroport* aero = aeroports_[evenement.indice];
+
+        etat.prochainMs = std::numeric_limits<long long>::max();
+        planifierControleur(etat, TypeEvenement::CONTROLEUR_APP, evenement.indice, maintenantMs_ + DELAI_SECURITE_CONTROLEUR_MS);
+
+        preparerControleur([aero](const PiloteAvion& pilote) { return pilote.aeroArrivee == aero; });
+        aero->app->mettreAJour();
+        verifierModifications();
+        planifierControleur(etat, TypeEvenement::CONTROLEUR_APP, evenement.indice,
+            maintenantMs_ + aero->app->delaiReveil(DELAI_SECURITE_CONTROLEUR_MS));
+        break;
+    }
+    case TypeEvenement::ACTION: {
+        std::function<void()> action = std::move(actions_[evenement.indice]);
+        actions_[evenement.indice] = nullptr;
+        actionsLibres_.push_back(evenement.indice);
+        action();
+        break;
+    }
+    }
+    ++nbEvenements_;
+}
+
+void MoteurEvenements::executerJusqua(long long finMs) {
+    HorlogeSimulation& horloge = HorlogeSimulation::getInstance();
+
+    while (!file_.empty() && file_.top().tempsMs <= finMs && simulation_en_cours()) {
+        Evenement evenement = file_.top();
+        file_.pop();
+        maintenantMs_ = evenement.tempsMs;
+        horloge.imposerTemps(maintenantMs_);
+        traiter(evenement);
+    }
+
+    maintenantMs_ = std::max(maintenantMs_, finMs);
+    horloge.imposerTemps(maintenantMs_);
+    for (EntreePilote& entree : pilotes_) {
+        if (!entree.termine) synchroniser(entree);
+    }
+}
+
+long long MoteurEvenements::maintenantMs() const {
+    return maintenantMs_;
+}
+
+size_t MoteurEvenements::getNombrePilotes() const {
+    return static_cast<size_t>(std::count_if(pilotes_.begin(), pilotes_.end(),
+        [](const EntreePilote& entree) { return !entree.termine; }));
+}
+
+unsigned long long MoteurEvenements::getNbEvenements() const {
+    return nbEvenements_;
+}
+
+unsigned long long MoteurEvenements::getNbPasSautes() const {
+    return nbPasSautes_;
+}
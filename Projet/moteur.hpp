@@ -0,0 +1,135 @@
+#pragma once
+#include <queue>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "thread.hpp"
+
+// Moteur à événements discrets : une file de priorité d'événements datés remplace les threads.
+// Les pilotes, la CCR, les TWR et les APP exécutent exactement le même code qu'en mode threads
+// (pas_avion, gererEspaceAerien, pas_twr, mettreAJour), aux mêmes instants ; seuls les pas
+// où il ne se passe rien sont sautés :
+// - un avion en ligne droite avance d'un bloc de pas (Avion::pasSansEvenement) jusqu'au
+//   prochain point, seuil de carburant, altitude de sortie de montée, ou pas dont le tirage
+//   d'urgence se déclenche ; les tirages des pas sautés sont consommés, si bien que pour une
+//   même graine les urgences tombent aux mêmes pas que lorsque chaque pas est joué ;
+// - un avion qui attend la TWR (file, seuil de piste) dort jusqu'à ce qu'on le modifie ;
+// - la CCR saute les passes qui ne peuvent ni séparer ni transférer (CCR::pasSansIntervention) ;
+// - la TWR et l'APP sont réveillées par leurs signaux, redirigés vers la file.
+// Un contrôleur qui modifie un avion (version changée) annule son bloc : l'avion reprend
+// pas à pas au tick suivant. Mono-thread, piloté par executerJusqua ; l'horloge est
+// mise à l'heure de chaque événement. Sans sauts (setSauts(false)), chaque pas pilote et chaque
+// passe CCR est joué : la référence contre laquelle vérifier que les sauts ne changent rien.
+class MoteurEvenements {
+private:
+    // À temps égal, dans cet ordre : les actions, puis les pilotes, puis les contrôleurs
+    enum class TypeEvenement {
+        ACTION,
+        PAS_PILOTE,
+        PASSE_CCR,
+        CONTROLEUR_TWR,
+        CONTROLEUR_APP
+    };
+
+    struct Evenement {
+        long long tempsMs;
+        uint64_t sequence;      // en dernier recours, ordre de planification
+        TypeEvenement type;
+        uint32_t indice;
+        uint32_t generation;    // événement périmé si l'entité a été replanifiée depuis
+
+        // L'ordre à temps égal ne dépend pas de l'instant de planification, qui change selon
+        // que les pas sont sautés ou non : sinon un contrôleur passerait avant ou après un pilote
+        // du même instant selon le mode
+        bool operator>(const Evenement& autre) const {
+            if (tempsMs != autre.tempsMs) return tempsMs > autre.tempsMs;
+            if (type != autre.type) return type > autre.type;
+            // Les actions, planifiées par le scénario, gardent leur ordre de planification
+            if (type != TypeEvenement::ACTION && indice != autre.indice) return indice > autre.indice;
+            return sequence > autre.sequence;
+        }
+    };
+
+    struct EntreePilote {
+        PiloteAvion pilote;
+        uint32_t generation = 0;
+        bool termine = false;
+
+        // Bloc de pas sautés, de durée periodeMs chacun, depuis debutMs
+        bool enBloc = false;
+        bool enMouvement = false;   // false : attente pure, rien à appliquer
+        bool auSol = false;
+        bool decompteUrgence = false;
+        long long debutMs = 0;
+        int periodeMs = PERIODE_PILOTE_MS;
+        int pasBloc = 0;
+        int pasAppliques = 0;
+        uint32_t version = 0;
+    };
+
+    struct EtatControleur {
+        uint32_t generation = 0;
+        long long prochainMs = 0;
+    };
+
+    CCR& ccr_;
+    const std::vector<Aeroport*>& aeroports_;
+    std::priority_queue<Evenement, std::vector<Evenement>, std::greater<Evenement>> file_;
+    uint64_t sequence_;
+    long long maintenantMs_;
+
+    std::vector<EntreePilote> pilotes_;
+    std::vector<uint32_t> pilotesLibres_;   // entrées de pilotes terminés, reprises par ajouterPilote
+    std::vector<EtatControleur> twr_;
+    std::vector<EtatControleur> app_;
+    EtatControleur ccrEtat_;
+    long long dernierePasseCCRMs_;     // origine de la grille des passes CCR
+    std::vector<std::function<void()>> actions_;
+    std::vector<uint32_t> actionsLibres_;   // cases d'actions déjà exécutées, reprises par planifier
+    std::vector<size_t> concernes_;
+
+    bool sauts_;
+    unsigned long long nbEvenements_;
+    unsigned long long nbPasSautes_;
+
+    void pousser(long long tempsMs, TypeEvenement type, uint32_t indice, uint32_t generation);
+    void planifierControleur(EtatControleur& etat, TypeEvenement type, uint32_t indice, long long tempsMs);
+    void reveillerCCR();
+
+    void planifierPilote(size_t indice, int attenteMs);
+    void synchroniser(EntreePilote& entree);
+    // Synchronise les pilotes concernés par un contrôleur, puis après son passage
+    // replanifie au tick suivant ceux qu'il a modifiés
+    template <typename Predicat>
+    void preparerControleur(Predicat&& concerne);
+    void verifierModifications();
+
+    void traiter(const Evenement& evenement);
+    void traiterPilote(size_t indice);
+    void traiterCCR();
+
+public:
+    MoteurEvenements(CCR& ccr, const std::vector<Aeroport*>& aeroports);
+    ~MoteurEvenements();
+
+    MoteurEvenements(const MoteurEvenements&) = delete;
+    MoteurEvenements& operator=(const MoteurEvenements&) = delete;
+
+    // À fixer avant demarrer (par défaut, sauts actifs)
+    void setSauts(bool actifs);
+    // Redirige les signaux des contrôleurs et planifie leurs premiers passages
+    void demarrer();
+    // Premier pas du pilote à l'instant courant
+    void ajouterPilote(const PiloteAvion& pilote);
+    // Action ponctuelle (arrivée de trafic...) exécutée à tempsMs
+    void planifier(long long tempsMs, std::function<void()> action);
+
+    // Traite tous les événements jusqu'à finMs inclus ; les avions en plein bloc sont
+    // ensuite remis à leur position à finMs
+    void executerJusqua(long long finMs);
+
+    long long maintenantMs() const;
+    size_t getNombrePilotes() const;
+    unsigned long long getNbEvenements() const;
+    unsigned long long getNbPasSautes() const;
+};
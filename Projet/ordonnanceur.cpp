@@ -0,0 +1,118 @@
+#include "ordonnanceur.hpp"
+#include "horloge.hpp"
+#include "cinematique.hpp"
+#include <algorithm>
+
+OrdonnanceurTicks::OrdonnanceurTicks(int nbTravailleurs)
+    : pool_(nbTravailleurs), tick_(0), actif_(false) {
+}
+
+OrdonnanceurTicks::~OrdonnanceurTicks() {
+    arreter();
+}
+
+void OrdonnanceurTicks::ajouter(const PiloteAvion& pilote) {
+    std::lock_guard<std::mutex> lock(mutexNouveaux_);
+    nouveaux_.push_back({ pilote, 0 });
+}
+
+void OrdonnanceurTicks::setApresTick(std::function<void()> rappel) {
+    apresTick_ = std::move(rappel);
+}
+
+long long OrdonnanceurTicks::getTick() const {
+    return tick_;
+}
+
+size_t OrdonnanceurTicks::getNombrePilotes() const {
+    return pilotes_.size();
+}
+
+void OrdonnanceurTicks::executerTick() {
+    // Les avions créés pendant le tick précédent entrent au tick courant, dans leur ordre d'ajout
+    {
+        std::lock_guard<std::mutex> lock(mutexNouveaux_);
+        for (Entree& e : nouveaux_) {
+            e.prochainTick = tick_;
+            pilotes_.push_back(e);
+        }
+        nouveaux_.clear();
+    }
+
+    const long long tickCourant = tick_;
+    auto planifier = [tickCourant](Entree& e, int attenteMs) {
+        long long nbTicks = (attenteMs + PERIODE_PILOTE_MS - 1) / PERIODE_PILOTE_MS;
+        e.prochainTick = tickCourant + std::max(1LL, nbTicks);
+    };
+
+    // Chaque tranche commence les pas de ses pilotes dus, déplace leurs avions en un seul lot
+    // (Avion::avancerGroupe) puis termine les pas, dans l'ordre des pilotes
+    pool_.executer(pilotes_.size(), [this, tickCourant, &planifier](size_t debut, size_t fin) {
+        thread_local std::vector<size_t> enCours;
+        thread_local std::vector<PasPilote> pas;
+        thread_local std::vector<Avion*> avions;
+        thread_local std::vector<uint8_t> auSol;
+        thread_local LotCinematique lot;
+        enCours.clear();
+        pas.clear();
+        avions.clear();
+        auSol.clear();
+
+        for (size_t i = debut; i < fin; ++i) {
+            Entree& e = pilotes_[i];
+            if (e.prochainTick > tickCourant) continue;
+
+            PasPilote p = commencer_pas_avion(e.pilote);
+            if (p.attenteMs >= 0) {
+                planifier(e, p.attenteMs);
+                continue;
+            }
+            if (p.mouvement != MouvementPilote::AUCUN) {
+                avions.push_back(e.pilote.avion);
+                auSol.push_back(p.mouvement == MouvementPilote::SOL);
+            }
+            enCours.push_back(i);
+            pas.push_back(p);
+        }
+
+        Avion::avancerGroupe(avions, auSol, DT_PILOTE, lot);
+
+        for (size_t k = 0; k < enCours.size(); ++k) {
+            Entree& e = pilotes_[enCours[k]];
+            planifier(e, terminer_pas_avion(e.pilote, pas[k]));
+        }
+    });
+
+    // Retrait des avions terminés en conservant l'ordre (déterminisme du découpage) ; leur
+    // avion est rendu au registre
+    for (Entree& e : pilotes_) {
+        if (e.pilote.avion->getEtat() == EtatAvion::TERMINE) rendre_avion(e.pilote);
+    }
+    pilotes_.erase(std::remove_if(pilotes_.begin(), pilotes_.end(), [](const Entree& e) {
+        return e.pilote.avion == nullptr;
+    }), pilotes_.end());
+
+    ++tick_;
+
+    if (apresTick_) apresTick_();
+}
+
+void OrdonnanceurTicks::boucle() {
+    HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+    while (actif_ && simulation_en_cours()) {
+        executerTick();
+        simuler_pause(PERIODE_PILOTE_MS);
+    }
+}
+
+void OrdonnanceurTicks::demarrer() {
+    if (actif_) return;
+    actif_ = true;
+    HorlogeSimulation::getInstance().enregistrerParticipant();
+    thread_ = std::thread(&OrdonnanceurTicks::boucle, this);
+}
+
+void OrdonnanceurTicks::arreter() {
+    actif_ = false;
+    if (thread_.joinable()) thread_.join();
+}
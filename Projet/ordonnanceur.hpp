@@ -0,0 +1,48 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <functional>
+#include "thread.hpp"
+#include "pool.hpp"
+
+// Fait avancer tous les pilotes par ticks fixes de PERIODE_PILOTE_MS depuis un petit pool
+// de travailleurs, au lieu d'un thread détaché par avion. Chaque pilote garde la machine à
+// états de pas_avion ; ses attentes (escale, file de décollage...) deviennent un tick de réveil.
+// Les déplacements des avions d'une même tranche sont calculés ensemble (Avion::avancerGroupe).
+// L'ordre des pilotes est fixe, mais TWR, APP et CCR gardent leurs threads : leurs réponses
+// arrivent à des ticks qui varient d'une exécution à l'autre. Seul le moteur à événements est reproductible.
+class OrdonnanceurTicks {
+private:
+    struct Entree {
+        PiloteAvion pilote;
+        long long prochainTick;
+    };
+
+    PoolTravailleurs pool_;
+    std::vector<Entree> pilotes_;
+    std::vector<Entree> nouveaux_;
+    std::mutex mutexNouveaux_;
+    long long tick_;
+    std::thread thread_;
+    std::atomic<bool> actif_;
+    std::function<void()> apresTick_;
+
+    void boucle();
+
+public:
+    explicit OrdonnanceurTicks(int nbTravailleurs);
+    ~OrdonnanceurTicks();
+
+    OrdonnanceurTicks(const OrdonnanceurTicks&) = delete;
+    OrdonnanceurTicks& operator=(const OrdonnanceurTicks&) = delete;
+
+    void ajouter(const PiloteAvion& pilote);
+    // Appelé par le thread de l'ordonnanceur à la fin de chaque tick (à fixer avant demarrer)
+    void setApresTick(std::function<void()> rappel);
+    void executerTick();
+    long long getTick() const;
+    size_t getNombrePilotes() const;
+
+    void demarrer();
+    void arreter();
+};
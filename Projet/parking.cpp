@@ -1,7 +1,8 @@
 #include "avion.hpp"
+#include "allocateurparkings.hpp"
 
-Parking::Parking(const std::string& nom, Position pos)
-    : nom_(nom), pos_(pos), occupe_(false) {
+Parking::Parking(const std::string& nom, Position pos, CategorieAvion gabarit)
+    : nom_(nom), pos_(pos), gabarit_(gabarit), allocateur_(nullptr), rang_(0) {
 }
 
 const std::string& Parking::getNom() const { return nom_; }
@@ -14,6 +15,12 @@ const Position& Parking::getPosition() const {
     return pos_;
 }
 
-bool Parking::estOccupe() const { return occupe_; }
-void Parking::occuper() { occupe_ = true; }
-void Parking::liberer() { occupe_ = false; }
+CategorieAvion Parking::getGabarit() const { return gabarit_; }
+
+bool Parking::estOccupe() const {
+    return allocateur_ && allocateur_->estOccupe(*this);
+}
+
+void Parking::liberer() {
+    if (allocateur_) allocateur_->liberer(*this);
+}
@@ -0,0 +1,96 @@
+#include "piste.hpp"
+#include <algorithm>
+#include <limits>
+
+Piste::Piste(const std::string& nom, const Position& position, long long dureeOccupationMs)
+    : nom_(nom), position_(position), dureeOccupationMs_(dureeOccupationMs), depart_(nullptr),
+    derniereUtilisationMs_(std::numeric_limits<long long>::min()) {
+}
+
+const std::string& Piste::getNom() const { return nom_; }
+
+const Position& Piste::getPosition() const { return position_; }
+
+long long Piste::getDureeOccupationMs() const { return dureeOccupationMs_; }
+
+long long Piste::getDerniereUtilisationMs() const { return derniereUtilisationMs_; }
+
+Avion* Piste::getDepart() const { return depart_; }
+
+void Piste::setDepart(Avion* avion) { depart_ = avion; }
+
+bool Piste::estLibre(long long tMs) const {
+    return occupants_.empty() && prochainCreneau(tMs) == tMs;
+}
+
+bool Piste::estDegagee() const {
+    return occupants_.empty();
+}
+
+long long Piste::prochainCreneau(long long apresMs) const {
+    long long candidat = apresMs;
+
+    // Le créneau qui commence avant le candidat peut encore le couvrir
+    auto it = creneaux_.upper_bound(candidat);
+    if (it != creneaux_.begin()) --it;
+
+    for (; it != creneaux_.end(); ++it) {
+        long long debut = it->first;
+        if (debut >= candidat + dureeOccupationMs_) break;
+        if (it->second.finMs > candidat) candidat = it->second.finMs;
+    }
+    return candidat;
+}
+
+long long Piste::prochaineFin(long long tMs) const {
+    long long fin = -1;
+    for (const auto& [debut, creneau] : creneaux_) {
+        if (creneau.finMs > tMs && (fin < 0 || creneau.finMs < fin)) fin = creneau.finMs;
+        if (fin >= 0 && debut >= fin) break;
+    }
+    return fin;
+}
+
+void Piste::reserver(long long debutMs, uint32_t idAvion) {
+    creneaux_.emplace(debutMs, Creneau{ debutMs + dureeOccupationMs_, idAvion });
+}
+
+void Piste::annuler(long long debutMs, uint32_t idAvion) {
+    auto [debut, fin] = creneaux_.equal_range(debutMs);
+    auto it = std::find_if(debut, fin, [idAvion](const auto& creneau) { return creneau.second.idAvion == idAvion; });
+    if (it != fin) creneaux_.erase(it);
+}
+
+void Piste::occuper(const Avion* avion, long long tMs) {
+    reserver(tMs, avion->getId());
+    occupants_.push_back(avion);
+    derniereUtilisationMs_ = tMs;
+}
+
+void Piste::occuperCreneau(const Avion* avion, long long debutMs) {
+    occupants_.push_back(avion);
+    derniereUtilisationMs_ = debutMs;
+}
+
+bool Piste::liberer(const Avion* avion) {
+    auto it = std::find(occupants_.begin(), occupants_.end(), avion);
+    if (it == occupants_.end()) return false;
+    occupants_.erase(it);
+    return true;
+}
+
+void Piste::oublier(const Avion* avion) {
+    liberer(avion);
+    if (depart_ == avion) depart_ = nullptr;
+}
+
+void Piste::purger(long long tMs) {
+    for (auto it = creneaux_.begin(); it != creneaux_.end() && it->first < tMs; ) {
+        if (it->second.finMs <= tMs) it = creneaux_.erase(it);
+        else ++it;
+    }
+
+    // Un avion écrasé sur la piste ou au roulage ne la libérera jamais
+    std::erase_if(occupants_, [](const Avion* avion) { return avion->getEtat() == EtatAvion::TERMINE; });
+    if (depart_ && depart_->getEtat() == EtatAvion::TERMINE) depart_ = nullptr;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "avion.hpp"
+
+// Piste d'un aérodrome et sa chronologie d'occupation, en temps simulé.
+// Chaque mouvement (atterrissage ou décollage) réserve un créneau de dureeOccupationMs à partir
+// de son autorisation ; l'avion tient en plus la piste tant qu'il ne l'a pas dégagée.
+// Des créneaux peuvent aussi être réservés à l'avance. Non protégée : la TWR la verrouille.
+class Piste {
+private:
+    struct Creneau {
+        long long finMs;
+        uint32_t idAvion;
+    };
+
+    std::string nom_;
+    Position position_;
+    long long dureeOccupationMs_;
+    // Par instant de début ; une urgence autorisée sans créneau peut partager le début d'un autre
+    std::multimap<long long, Creneau> creneaux_;
+    std::vector<const Avion*> occupants_;
+    Avion* depart_;              // avion qui roule vers la piste ou attend au seuil pour décoller
+    long long derniereUtilisationMs_;
+
+public:
+    Piste(const std::string& nom, const Position& position, long long dureeOccupationMs);
+
+    const std::string& getNom() const;
+    const Position& getPosition() const;
+    long long getDureeOccupationMs() const;
+    long long getDerniereUtilisationMs() const;
+    Avion* getDepart() const;
+    void setDepart(Avion* avion);
+
+    // Personne sur la piste et un créneau complet disponible à partir de tMs
+    bool estLibre(long long tMs) const;
+    bool estDegagee() const;
+    // Premier instant >= apresMs où un créneau complet est disponible (occupants ignorés)
+    long long prochainCreneau(long long apresMs) const;
+    // Fin du premier créneau qui se termine après tMs ; -1 s'il n'y en a pas
+    long long prochaineFin(long long tMs) const;
+
+    void reserver(long long debutMs, uint32_t idAvion);
+    void annuler(long long debutMs, uint32_t idAvion);
+    // Mouvement autorisé à tMs : créneau réservé et avion sur la piste
+    void occuper(const Avion* avion, long long tMs);
+    // Avion arrivé sur le créneau qu'il avait réservé à debutMs
+    void occuperCreneau(const Avion* avion, long long debutMs);
+    bool liberer(const Avion* avion);
+    // Avion sur le point d'être détruit : ni occupant ni départ (ses créneaux restent jusqu'à leur fin)
+    void oublier(const Avion* avion);
+    // Oublie les créneaux terminés et les avions qui ne bougeront plus
+    void purger(long long tMs);
+};
@@ -0,0 +1,75 @@
+#include "pool.hpp"
+#include <algorithm>
+
+PoolTravailleurs::PoolTravailleurs(int nbTravailleurs)
+    : taille_(0), prochaineTranche_(0), nbTranches_(0), tranchesRestantes_(0),
+    generation_(0), arret_(false) {
+    for (int i = 0; i < nbTravailleurs; ++i) {
+        travailleurs_.emplace_back(&PoolTravailleurs::boucleTravailleur, this);
+    }
+}
+
+PoolTravailleurs::~PoolTravailleurs() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        arret_ = true;
+    }
+    cvTravail_.notify_all();
+    for (auto& t : travailleurs_) {
+        t.join();
+    }
+}
+
+int PoolTravailleurs::getNombreTravailleurs() const {
+    return static_cast<int>(travailleurs_.size());
+}
+
+// Prend une tranche libre et la traite hors verrou ; renvoie false s'il n'en reste plus
+bool PoolTravailleurs::executerTranche(std::unique_lock<std::mutex>& lock) {
+    if (prochaineTranche_ >= nbTranches_) return false;
+
+    size_t indice = prochaineTranche_++;
+    size_t debut = taille_ * indice / nbTranches_;
+    size_t fin = taille_ * (indice + 1) / nbTranches_;
+
+    lock.unlock();
+    tache_(debut, fin);
+    lock.lock();
+
+    if (--tranchesRestantes_ == 0) {
+        cvFin_.notify_all();
+    }
+    return true;
+}
+
+void PoolTravailleurs::boucleTravailleur() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    unsigned long long vue = generation_;
+
+    while (true) {
+        cvTravail_.wait(lock, [&] { return arret_ || generation_ != vue; });
+        if (arret_) return;
+        vue = generation_;
+
+        while (executerTranche(lock)) {}
+    }
+}
+
+void PoolTravailleurs::executer(size_t n, const std::function<void(size_t debut, size_t fin)>& tache) {
+    if (n == 0) return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    tache_ = tache;
+    taille_ = n;
+    nbTranches_ = std::min(n, static_cast<size_t>(travailleurs_.size() + 1) * 4);
+    prochaineTranche_ = 0;
+    tranchesRestantes_ = nbTranches_;
+    ++generation_;
+    cvTravail_.notify_all();
+
+    // Le thread appelant participe aussi
+    while (executerTranche(lock)) {}
+
+    cvFin_.wait(lock, [&] { return tranchesRestantes_ == 0; });
+    tache_ = nullptr;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+// Petit pool de threads à tâches découpées : executer() partage [0, n) en tranches
+// contiguës entre les travailleurs et rend la main quand toutes sont traitées.
+class PoolTravailleurs {
+private:
+    std::vector<std::thread> travailleurs_;
+    std::mutex mutex_;
+    std::condition_variable cvTravail_;
+    std::condition_variable cvFin_;
+    std::function<void(size_t, size_t)> tache_;
+    size_t taille_;
+    size_t prochaineTranche_;
+    size_t nbTranches_;
+    size_t tranchesRestantes_;
+    unsigned long long generation_;
+    bool arret_;
+
+    void boucleTravailleur();
+    bool executerTranche(std::unique_lock<std::mutex>& lock);
+
+public:
+    explicit PoolTravailleurs(int nbTravailleurs);
+    ~PoolTravailleurs();
+
+    PoolTravailleurs(const PoolTravailleurs&) = delete;
+    PoolTravailleurs& operator=(const PoolTravailleurs&) = delete;
+
+    int getNombreTravailleurs() const;
+    void executer(size_t n, const std::function<void(size_t debut, size_t fin)>& tache);
+};
@@ -0,0 +1,125 @@
+#include "registreavions.hpp"
+#include "etatflotte.hpp"
+
+RegistreAvions::RegistreAvions() : nbEmplacements_(0), nbActifs_(0), nbRecycles_(0) {}
+
+RegistreAvions::~RegistreAvions() = default;
+
+RegistreAvions::Emplacement& RegistreAvions::emplacement(uint32_t indice) const {
+    return blocs_[indice / TAILLE_BLOC_REGISTRE][indice % TAILLE_BLOC_REGISTRE];
+}
+
+void RegistreAvions::reserver(size_t nbAvions) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (blocs_.size() * TAILLE_BLOC_REGISTRE < nbAvions) {
+        blocs_.push_back(std::make_unique<Emplacement[]>(TAILLE_BLOC_REGISTRE));
+    }
+    libres_.reserve(nbAvions);
+    retires_.reserve(nbAvions);
+}
+
+PoigneeAvion RegistreAvions::creer(const std::string& nom, float vitesse, float vitesseSol, float carburant,
+    float consommation, float dureeStationnement, const Position& position) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Un emplacement recyclé garde son Avion et sa place dans EtatFlotte ; un nouveau en demande une
+    if (libres_.empty() && EtatFlotte::getInstance().estComplete()) return PoigneeAvion{};
+
+    uint32_t indice;
+    if (!libres_.empty()) {
+        indice = libres_.back();
+        libres_.pop_back();
+    }
+    else {
+        indice = static_cast<uint32_t>(nbEmplacements_++);
+        if (indice == blocs_.size() * TAILLE_BLOC_REGISTRE) {
+            blocs_.push_back(std::make_unique<Emplacement[]>(TAILLE_BLOC_REGISTRE));
+        }
+    }
+
+    Emplacement& e = emplacement(indice);
+    if (e.avion) e.avion->reprendre(nom, vitesse, vitesseSol, carburant, consommation, dureeStationnement, position);
+    else e.avion.emplace(nom, vitesse, vitesseSol, carburant, consommation, dureeStationnement, position);
+    e.actif = true;
+    ++nbActifs_;
+    return PoigneeAvion{ indice, e.generation };
+}
+
+Avion* RegistreAvions::trouver(PoigneeAvion poignee) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (poignee.estNulle() || poignee.indice >= nbEmplacements_) return nullptr;
+    Emplacement& e = emplacement(poignee.indice);
+    return (e.actif && e.generation == poignee.generation) ? &*e.avion : nullptr;
+}
+
+bool RegistreAvions::retirer(PoigneeAvion poignee) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (poignee.estNulle() || poignee.indice >= nbEmplacements_) return false;
+    Emplacement& e = emplacement(poignee.indice);
+    if (!e.actif || e.generation != poignee.generation) return false;
+
+    e.actif = false;
+    // 0 reste réservé à la poignée nulle
+    if (++e.generation == 0) e.generation = 1;
+    retires_.push_back(poignee.indice);
+    --nbActifs_;
+    return true;
+}
+
+size_t RegistreAvions::recycler(const std::function<void(Avion*)>& oublier) {
+    std::lock_guard<std::mutex> recyclage(mutexRecyclage_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (retires_.empty()) return 0;
+        aRecycler_.swap(retires_);
+        epaves_.clear();
+        for (uint32_t indice : aRecycler_) epaves_.push_back(&*emplacement(indice).avion);
+    }
+
+    // Verrou du registre relâché pendant que les contrôleurs prennent les leurs ; les emplacements
+    // ne sont rendus qu'ensuite, quand plus personne ne désigne leur avion
+    for (Avion* avion : epaves_) {
+        oublier(avion);
+        Logger::getInstance().oublierAvion(avion->getId());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    libres_.insert(libres_.end(), aRecycler_.begin(), aRecycler_.end());
+    size_t nb = aRecycler_.size();
+    nbRecycles_ += nb;
+    aRecycler_.clear();
+    return nb;
+}
+
+void RegistreAvions::vider() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Les emplacements libres ont déjà été oubliés du Logger : oublier deux fois est sans effet
+    for (size_t i = 0; i < nbEmplacements_; ++i) {
+        const Emplacement& e = emplacement(static_cast<uint32_t>(i));
+        if (e.avion) Logger::getInstance().oublierAvion(e.avion->getId());
+    }
+    blocs_.clear();
+    nbEmplacements_ = 0;
+    libres_.clear();
+    retires_.clear();
+    nbActifs_ = 0;
+}
+
+size_t RegistreAvions::getNbActifs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nbActifs_;
+}
+
+size_t RegistreAvions::getNbEmplacements() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nbEmplacements_;
+}
+
+size_t RegistreAvions::getCapacite() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return blocs_.size() * TAILLE_BLOC_REGISTRE;
+}
+
+unsigned long long RegistreAvions::getNbRecycles() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nbRecycles_;
+}
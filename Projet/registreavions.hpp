@@ -0,0 +1,97 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "avion.hpp"
+
+// Poignée d'un avion du registre : son emplacement et la génération de l'emplacement quand il y a
+// été inscrit. Dès que l'avion est retiré, la génération change et la poignée ne désigne plus rien,
+// même si l'emplacement accueille ensuite un autre avion.
+struct PoigneeAvion {
+    uint32_t indice = 0;
+    uint32_t generation = 0;    // 0 : poignée nulle, jamais distribuée
+
+    bool estNulle() const { return generation == 0; }
+    bool operator==(const PoigneeAvion&) const = default;
+};
+
+// Emplacements alloués d'un coup quand le registre s'agrandit
+constexpr size_t TAILLE_BLOC_REGISTRE = 64;
+
+// Propriétaire des avions de la simulation : un pool d'emplacements réutilisables, alloués par blocs
+// de TAILLE_BLOC_REGISTRE et jamais rendus avant vider().
+// Cycle de vie : creer (création du vol), retirer (le pilote lâche son avion TERMINE), puis
+// recycler : chaque avion retiré est oublié des contrôleurs qui gardent encore son adresse et du
+// Logger (son nom), et son emplacement sert au prochain vol. L'objet Avion y reste construit : le vol suivant le réarme
+// (Avion::reprendre), avec son emplacement dans EtatFlotte et la mémoire de sa trajectoire.
+// En régime établi, un vol ne passe donc plus par le tas, et la mémoire reste bornée par le nombre
+// d'avions présents à la fois. Protégé par son propre verrou.
+
+class RegistreAvions {
+private:
+    struct Emplacement {
+        std::optional<Avion> avion;     // construit au premier vol, réarmé ensuite
+        uint32_t generation = 1;
+        bool actif = false;             // inscrit et pas encore retiré
+    };
+
+    // Les blocs ne bougent jamais : un Emplacement garde son adresse tant que le registre vit
+    std::vector<std::unique_ptr<Emplacement[]>> blocs_;
+    size_t nbEmplacements_;             // emplacements déjà servis, au début des blocs
+    std::vector<uint32_t> libres_;      // recyclés, repris avant d'en ouvrir un nouveau
+    std::vector<uint32_t> retires_;     // avion retiré, en attente de recycler
+    size_t nbActifs_;
+    unsigned long long nbRecycles_;
+    mutable std::mutex mutex_;
+
+    // Tampons de recycler, gardés d'un appel à l'autre (un recyclage à la fois)
+    std::mutex mutexRecyclage_;
+    std::vector<uint32_t> aRecycler_;
+    std::vector<Avion*> epaves_;
+
+    // Les blocs sont pointés : même depuis une méthode const, l'emplacement reste modifiable
+    Emplacement& emplacement(uint32_t indice) const;
+
+public:
+    RegistreAvions();
+    ~RegistreAvions();
+
+    RegistreAvions(const RegistreAvions&) = delete;
+    RegistreAvions& operator=(const RegistreAvions&) = delete;
+
+    // Prépare de quoi tenir nbAvions avions à la fois sans autre allocation
+    void reserver(size_t nbAvions);
+    // Nouvel avion (mêmes paramètres que le constructeur d'Avion), dans un emplacement recyclé si possible ;
+    // poignée nulle si EtatFlotte n'a plus d'emplacement pour un avion de plus
+    PoigneeAvion creer(const std::string& nom, float vitesse, float vitesseSol, float carburant,
+        float consommation, float dureeStationnement, const Position& position);
+    // nullptr si la poignée est nulle ou périmée (avion retiré, emplacement repris)
+    Avion* trouver(PoigneeAvion poignee) const;
+    // false si la poignée était déjà périmée
+    bool retirer(PoigneeAvion poignee);
+    // Pour chaque avion retiré : oublier(avion), hors du verrou du registre, puis son nom est oublié
+    // du Logger et son emplacement rendu. Renvoie le nombre d'avions recyclés.
+    size_t recycler(const std::function<void(Avion*)>& oublier);
+    // Détruit tous les avions, retirés ou non : plus aucun pilote ni contrôleur ne doit tourner
+    void vider();
+
+    // f(const Avion&) sur chaque avion actif, sous le verrou du registre
+    template <typename Fonction>
+    void pourChaqueActif(Fonction&& f) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < nbEmplacements_; ++i) {
+            const Emplacement& e = emplacement(static_cast<uint32_t>(i));
+            if (e.actif) f(static_cast<const Avion&>(*e.avion));
+        }
+    }
+
+    size_t getNbActifs() const;
+    // Emplacements servis depuis le début : le plus grand nombre d'avions présents à la fois
+    size_t getNbEmplacements() const;
+    // Emplacements alloués, servis ou non
+    size_t getCapacite() const;
+    unsigned long long getNbRecycles() const;
+};
@@ -0,0 +1,323 @@
+#include "scenario.hpp"
+#include "thread.hpp"
+#include "horloge.hpp"
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+Scenario::Scenario() : Scenario(DescriptionScenario::parDefaut()) {
+}
+
+Scenario::Scenario(const DescriptionScenario& description)
+    : pilotesActifs_(0), instantanesActives_(false),
+    tirages_((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}()),
+    enregistrerTirages_(false), volsRestants_(0), prochainIdVol_(1), intervalleTraficMs_(0),
+    types_(description.types), programme_(description.vols), prochainVolProgramme_(0), debutProgrammeMs_(0) {
+    aeroports.reserve(description.aeroports.size());
+    for (const DescriptionAeroport& aero : description.aeroports) {
+        if (aero.parkings.empty()) {
+            aeroports.push_back(new Aeroport(aero.nom, aero.position, aero.rayonControle, aero.nbPistes));
+            continue;
+        }
+        std::vector<Parking> parkings;
+        parkings.reserve(aero.parkings.size());
+        for (const DescriptionParking& parking : aero.parkings) {
+            parkings.emplace_back(aero.nom + "-" + parking.nom,
+                Position(aero.position.getX() + parking.dx, aero.position.getY() + parking.dy, 0), parking.gabarit);
+        }
+        aeroports.push_back(new Aeroport(aero.nom, aero.position, aero.rayonControle, aero.nbPistes, std::move(parkings)));
+    }
+}
+
+Scenario::~Scenario() {
+    arreter();
+    for (Aeroport* aero : aeroports) {
+        delete aero;
+    }
+    aeroports.clear();
+}
+
+void Scenario::utiliserOrdonnanceur(int nbTravailleurs) {
+    ordonnanceur_ = std::make_unique<OrdonnanceurTicks>(nbTravailleurs);
+}
+
+void Scenario::utiliserMoteurEvenements(bool sauts) {
+    moteur_ = std::make_unique<MoteurEvenements>(ccr, aeroports);
+    moteur_->setSauts(sauts);
+}
+
+void Scenario::activerInstantanes() {
+    instantanesActives_ = true;
+}
+
+void Scenario::fixerGraine(uint64_t graine) {
+    tirages_.reinitialiser(graine);
+}
+
+void Scenario::enregistrerTirages(const std::string& chemin) {
+    enregistrerTirages_ = true;
+    cheminTirages_ = chemin;
+    tirages_.enregistrer();
+}
+
+bool Scenario::rejouerTirages(const std::string& chemin) {
+    return tirages_.charger(chemin);
+}
+
+uint64_t Scenario::getGraine() const {
+    return tirages_.getGraine();
+}
+
+const JournalTirages& Scenario::getJournalTirages() const {
+    return tirages_;
+}
+
+double Scenario::entreeExterne(const std::string& cle, double valeur) {
+    return tirages_.entree(cle, valeur);
+}
+
+void Scenario::publierInstantane() {
+    std::vector<EnregistrementRendu>& tampon = instantane.tamponArriere();
+    size_t n = 0;
+    flotte.pourChaqueActif([&](const Avion& avion) {
+        if (n == tampon.size()) tampon.emplace_back();
+        avion.remplirRendu(tampon[n]);
+        if (tampon[n].etat != EtatAvion::TERMINE) ++n;
+    });
+    tampon.resize(n);
+    instantane.publier();
+}
+
+void Scenario::demarrerControleurs() {
+    if (moteur_) {
+        moteur_->demarrer();
+        return;
+    }
+
+    HorlogeSimulation& horloge = HorlogeSimulation::getInstance();
+
+    horloge.enregistrerParticipant();
+    threadsInfra_.emplace_back(routine_ccr, std::ref(ccr));
+    for (Aeroport* aero : aeroports) {
+        horloge.enregistrerParticipant();
+        threadsInfra_.emplace_back(routine_twr, std::ref(*aero->twr));
+        horloge.enregistrerParticipant();
+        threadsInfra_.emplace_back(routine_app, std::ref(*aero->app));
+    }
+
+    if (ordonnanceur_) {
+        if (instantanesActives_) ordonnanceur_->setApresTick([this]() { publierInstantane(); });
+        ordonnanceur_->demarrer();
+    }
+    else if (instantanesActives_) {
+        horloge.enregistrerParticipant();
+        threadsInfra_.emplace_back([this]() {
+            HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+            while (simulation_en_cours()) {
+                publierInstantane();
+                simuler_pause(PERIODE_PILOTE_MS);
+            }
+        });
+    }
+}
+
+PiloteAvion Scenario::creerVol(FluxAleatoire& alea, int idVol) {
+    int nbAeroports = static_cast<int>(aeroports.size());
+    int idxDepart = alea.entier(nbAeroports);
+    int idxDest;
+    do { idxDest = alea.entier(nbAeroports); } while (idxDest == idxDepart);
+    // Un seul type : pas de tirage, la suite des tirages ne dépend pas de la description
+    int idxType = (types_.size() > 1) ? alea.entier(static_cast<int>(types_.size())) : 0;
+
+    return lancerVol(idVol, "AF-" + std::to_string(idVol), aeroports[idxDepart], aeroports[idxDest], types_[idxType]);
+}
+
+PiloteAvion Scenario::lancerVol(size_t indiceProgramme) {
+    const VolProgramme& vol = programme_[indiceProgramme];
+    int idVol = static_cast<int>(indiceProgramme) + 1;
+    return lancerVol(idVol, vol.nom.empty() ? "AF-" + std::to_string(idVol) : vol.nom,
+        aeroports[vol.depart], aeroports[vol.destination], types_[vol.type]);
+}
+
+PiloteAvion Scenario::lancerVol(int idVol, const std::string& nom, Aeroport* depart, Aeroport* destination, const TypeAvion& type) {
+    Position posDepart = depart->position;
+    posDepart.setPosition(posDepart.getX(), posDepart.getY() - 5000, 10000);
+
+    recyclerAvions();
+
+    PoigneeAvion poignee = flotte.creer(nom, type.vitesse, type.vitesseSol, type.carburant, type.consommation,
+        type.dureeStationnement, posDepart);
+    if (poignee.estNulle()) {
+        std::cout << "[SCENARIO] Flotte complete : vol " << nom << " annule.\n";
+        return PiloteAvion{};
+    }
+    Avion* nouvelAvion = flotte.trouver(poignee);
+    nouvelAvion->setCategorie(type.categorie);
+    nouvelAvion->setDestination(destination);
+
+    ccr.prendreEnCharge(nouvelAvion);
+
+    PiloteAvion pilote{};
+    pilote.avion = nouvelAvion;
+    pilote.aeroDepart = depart;
+    pilote.aeroArrivee = destination;
+    pilote.ccr = &ccr;
+    pilote.aeroports = &aeroports;
+    pilote.alea = FluxAleatoire(tirages_.getGraine(), static_cast<uint32_t>(idVol), &tirages_);
+    pilote.registre = &flotte;
+    pilote.poignee = poignee;
+    return pilote;
+}
+
+void Scenario::recyclerAvions() {
+    // De l'amont vers l'aval : un transfert CCR -> APP -> TWR en cours se termine sous le verrou
+    // du contrôleur qui le fait, avant que le suivant soit purgé à son tour
+    flotte.recycler([this](Avion* avion) {
+        ccr.oublier(avion);
+        for (Aeroport* aero : aeroports) {
+            aero->app->oublier(avion);
+            aero->twr->oublier(avion);
+        }
+        // Écrasé au roulage vers son parking : le parking ne sera jamais libéré autrement
+        if (Parking* parking = avion->getParking()) parking->liberer();
+    });
+}
+
+void Scenario::arriveeTrafic() {
+    PiloteAvion pilote = creerVol(aleaTrafic_, prochainIdVol_++);
+    if (pilote.avion) moteur_->ajouterPilote(pilote);
+    if (--volsRestants_ > 0) {
+        moteur_->planifier(moteur_->maintenantMs() + intervalleTraficMs_, [this]() { arriveeTrafic(); });
+    }
+}
+
+void Scenario::arriveeProgramme() {
+    PiloteAvion pilote = lancerVol(prochainVolProgramme_);
+    if (pilote.avion) moteur_->ajouterPilote(pilote);
+    if (++prochainVolProgramme_ < programme_.size()) {
+        moteur_->planifier(debutProgrammeMs_ + programme_[prochainVolProgramme_].heureMs, [this]() { arriveeProgramme(); });
+    }
+}
+
+void Scenario::confierPilote(const PiloteAvion& pilote) {
+    // Vol annulé faute de place dans la flotte
+    if (!pilote.avion) return;
+    if (ordonnanceur_) {
+        ordonnanceur_->ajouter(pilote);
+        return;
+    }
+    ++pilotesActifs_;
+    HorlogeSimulation::getInstance().enregistrerParticipant();
+    std::thread tPilote([this, pilote]() {
+        routine_avion(pilote);
+        --pilotesActifs_;
+    });
+    tPilote.detach();
+}
+
+void Scenario::genererTrafic(int nbAvions, int intervalleMs) {
+    if (!programme_.empty()) {
+        flotte.reserver(std::min(programme_.size(), static_cast<size_t>(AVIONS_PREALLOUES_MAX)));
+        // Un flux par vol, numéroté d'après sa place dans le programme
+        if (moteur_) {
+            debutProgrammeMs_ = moteur_->maintenantMs();
+            moteur_->planifier(debutProgrammeMs_ + programme_.front().heureMs, [this]() { arriveeProgramme(); });
+            return;
+        }
+
+        HorlogeSimulation::getInstance().enregistrerParticipant();
+        generateurTrafic_ = std::thread([this]() {
+            HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+            long long ecouleMs = 0;
+            for (size_t i = 0; i < programme_.size() && simulation_en_cours(); ++i) {
+                if (programme_[i].heureMs > ecouleMs) {
+                    simuler_pause(static_cast<int>(programme_[i].heureMs - ecouleMs));
+                    ecouleMs = programme_[i].heureMs;
+                }
+                if (!simulation_en_cours()) break;
+                confierPilote(lancerVol(i));
+            }
+        });
+        return;
+    }
+
+    nbAvions = static_cast<int>(entreeExterne("trafic.nb_avions", nbAvions));
+    intervalleMs = static_cast<int>(entreeExterne("trafic.intervalle_ms", intervalleMs));
+
+    // Assez d'avions d'avance pour le régime établi ; au-delà, le registre s'agrandit par blocs
+    flotte.reserver(static_cast<size_t>(std::clamp(nbAvions, 0, AVIONS_PREALLOUES_MAX)));
+
+    // Flux 0 pour le trafic, puis un flux par avion (numéro d'ordre de création)
+    if (moteur_) {
+        aleaTrafic_ = FluxAleatoire(tirages_.getGraine(), 0, &tirages_);
+        volsRestants_ = nbAvions;
+        intervalleTraficMs_ = intervalleMs;
+        if (nbAvions > 0) {
+            moteur_->planifier(moteur_->maintenantMs() + intervalleMs, [this]() { arriveeTrafic(); });
+        }
+        return;
+    }
+
+    HorlogeSimulation::getInstance().enregistrerParticipant();
+    generateurTrafic_ = std::thread([this, nbAvions, intervalleMs]() {
+        HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+        FluxAleatoire alea(tirages_.getGraine(), 0, &tirages_);
+        for (int i = 0; i < nbAvions && simulation_en_cours(); ++i) {
+            simuler_pause(intervalleMs);
+            confierPilote(creerVol(alea, i + 1));
+        }
+    });
+}
+
+size_t Scenario::getNbVolsProgrammes() const {
+    return programme_.size();
+}
+
+void Scenario::avancer(long long dureeMs) {
+    if (moteur_) {
+        moteur_->executerJusqua(moteur_->maintenantMs() + dureeMs);
+        if (instantanesActives_) publierInstantane();
+    }
+    else {
+        simuler_pause(static_cast<int>(dureeMs));
+    }
+}
+
+const MoteurEvenements* Scenario::getMoteur() const {
+    return moteur_.get();
+}
+
+void Scenario::arreterActeurs() {
+    arreter_simulation();
+
+    if (generateurTrafic_.joinable()) generateurTrafic_.join();
+    for (auto& t : threadsInfra_) {
+        if (t.joinable()) t.join();
+    }
+    threadsInfra_.clear();
+
+    if (ordonnanceur_) ordonnanceur_->arreter();
+
+    // Les pilotes sont détachés : on attend qu'ils aient quitté leur boucle
+    while (pilotesActifs_ > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void Scenario::arreter() {
+    arreterActeurs();
+    // Rend les signaux des contrôleurs à l'horloge avant de libérer les avions
+    moteur_.reset();
+
+    if (enregistrerTirages_) {
+        enregistrerTirages_ = false;
+        if (tirages_.sauvegarder(cheminTirages_)) {
+            std::cout << "[SCENARIO] Tirages enregistres dans " << cheminTirages_ << " (graine " << tirages_.getGraine() << ").\n";
+        }
+        else {
+            std::cerr << "Impossible de creer " << cheminTirages_ << "\n";
+        }
+    }
+
+    flotte.vider();
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <thread>
+#include <atomic>
+#include <memory>
+#include "avion.hpp"
+#include "ordonnanceur.hpp"
+#include "moteur.hpp"
+#include "instantane.hpp"
+#include "aleatoire.hpp"
+#include "registreavions.hpp"
+#include "descriptionscenario.hpp"
+
+// Avions préparés d'avance par genererTrafic (au plus)
+constexpr int AVIONS_PREALLOUES_MAX = 1024;
+
+// Monde simulé : aéroports, contrôleurs, flotte et threads associés, construits d'après une
+// DescriptionScenario. Partagé par le visualiseur SFML (main.cpp) et le pilote sans fenêtre (headless.cpp).
+class Scenario {
+private:
+    std::vector<std::thread> threadsInfra_;
+    std::thread generateurTrafic_;
+    std::atomic<int> pilotesActifs_;
+    std::unique_ptr<OrdonnanceurTicks> ordonnanceur_;
+    std::unique_ptr<MoteurEvenements> moteur_;
+    bool instantanesActives_;
+    JournalTirages tirages_;
+    bool enregistrerTirages_;
+    std::string cheminTirages_;
+
+    // Trafic planifié dans le moteur à événements (le mode threads garde ces valeurs en local)
+    FluxAleatoire aleaTrafic_;
+    int volsRestants_;
+    int prochainIdVol_;
+    int intervalleTraficMs_;
+
+    std::vector<TypeAvion> types_;
+    // Programme de trafic de la description (vide : trafic aléatoire), et prochain vol à lancer
+    // par le moteur à événements à partir de debutProgrammeMs_
+    std::vector<VolProgramme> programme_;
+    size_t prochainVolProgramme_;
+    long long debutProgrammeMs_;
+
+    // Crée un vol (départ, destination et type tirés dans alea) et le confie à la CCR
+    PiloteAvion creerVol(FluxAleatoire& alea, int idVol);
+    // Crée le vol décrit et le confie à la CCR ; pilote sans avion si la flotte est complète
+    PiloteAvion lancerVol(int idVol, const std::string& nom, Aeroport* depart, Aeroport* destination, const TypeAvion& type);
+    PiloteAvion lancerVol(size_t indiceProgramme);
+    // Détruit les avions rendus par leur pilote, après les avoir fait oublier des contrôleurs ;
+    // appelé avant chaque création de vol, pour que le vol suivant reprenne leur place
+    void recyclerAvions();
+    void arriveeTrafic();
+    void arriveeProgramme();
+    // Modes à threads : pilote confié à l'ordonnanceur, ou à un thread détaché
+    void confierPilote(const PiloteAvion& pilote);
+
+public:
+    CCR ccr;
+    std::vector<Aeroport*> aeroports;
+    RegistreAvions flotte;
+    PublicateurInstantane instantane;
+
+    // Monde de DescriptionScenario::parDefaut()
+    Scenario();
+    explicit Scenario(const DescriptionScenario& description);
+    ~Scenario();
+
+    Scenario(const Scenario&) = delete;
+    Scenario& operator=(const Scenario&) = delete;
+
+    // Options à fixer avant demarrerControleurs :
+    // - pilotage des avions par un pool de nbTravailleurs threads à ticks fixes
+    //   (sinon un thread détaché par avion)
+    void utiliserOrdonnanceur(int nbTravailleurs);
+    // - moteur à événements discrets, sans thread ; le temps n'avance que par avancer().
+    //   sauts = false : chaque pas est joué (voir MoteurEvenements::setSauts)
+    void utiliserMoteurEvenements(bool sauts = true);
+    // - publication d'un instantané de la flotte à chaque tick pour le visualiseur
+    void activerInstantanes();
+    // - graine des tirages aléatoires (par défaut tirée au hasard : exécution non reproductible)
+    void fixerGraine(uint64_t graine);
+    // - enregistrement de tous les tirages et entrées dans chemin, écrit par arreter()
+    void enregistrerTirages(const std::string& chemin);
+    // - rejeu d'un enregistrement : graine, entrées et tirages repris du fichier (false si illisible)
+    bool rejouerTirages(const std::string& chemin);
+
+    uint64_t getGraine() const;
+    const JournalTirages& getJournalTirages() const;
+    // Paramètre venu de l'extérieur (ligne de commande...) : noté, ou repris de l'enregistrement en rejeu
+    double entreeExterne(const std::string& cle, double valeur);
+
+    void demarrerControleurs();
+    void publierInstantane();
+    // Trafic aléatoire : nbAvions vols, un toutes les intervalleMs. Si la description a un
+    // programme de vols, c'est lui qui est suivi (nbAvions et intervalleMs ignorés).
+    void genererTrafic(int nbAvions, int intervalleMs);
+    size_t getNbVolsProgrammes() const;
+    // Laisse s'écouler dureeMs de temps simulé (attente sur l'horloge, ou exécution du moteur)
+    void avancer(long long dureeMs);
+    const MoteurEvenements* getMoteur() const;
+    // Arrête pilotes, contrôleurs et générateur de trafic sans rien libérer : les statistiques
+    // se lisent ensuite sur un monde figé
+    void arreterActeurs();
+    // arreterActeurs, puis enregistre les tirages et libère les avions
+    void arreter();
+};
@@ -1,164 +1,252 @@
 ﻿#include "thread.hpp"
+#include "horloge.hpp"
 #include <iostream>
 #include <chrono>
 #include <random>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
 // Modification : Valeur abaissée à 400 pour garantir des urgences fréquentes (~30s)
 // Avec une boucle de 75ms, cela fait environ 1 chance sur 400 toutes les 0.075s par avion en vol.
 #define PROBA_URGENCE 650
 
+static std::atomic<bool> simulationActive(true);
+
 void simuler_pause(int ms) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    HorlogeSimulation::getInstance().attendre(ms);
+}
+
+void arreter_simulation() {
+    simulationActive = false;
+    HorlogeSimulation::getInstance().interrompre();
+}
+
+bool simulation_en_cours() {
+    return simulationActive;
 }
 
 void routine_ccr(CCR& ccr) {
-    while (true) {
+    HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+    while (simulation_en_cours()) {
         ccr.gererEspaceAerien();
         // Modification : Vérification beaucoup plus fréquente (50ms au lieu de 500ms)
         // pour ne pas rater les croisements à haute vitesse.
-        simuler_pause(50); 
+        simuler_pause(PERIODE_CCR_MS);
     }
 }
 
 void routine_twr(TWR& twr) {
-    while (true) {
-        simuler_pause(500);
-
-        Avion* avionPret = twr.choisirAvionPourDecollage();
-
-        if (avionPret != nullptr) {
-            if (twr.estPisteLibre() && !twr.estUrgenceEnCours()) {
+    HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+    HorlogeSimulation& horloge = HorlogeSimulation::getInstance();
+    while (simulation_en_cours()) {
+        horloge.attendreSignal(twr.getSignal(), twr.delaiReveil(DELAI_SECURITE_CONTROLEUR_MS));
+        if (!simulation_en_cours()) break;
+        pas_twr(twr);
+    }
+}
 
-                twr.reserverPiste();
+void pas_twr(TWR& twr) {
+    std::vector<Avion*> prets;
+    twr.choisirAvionsPourDecollage(prets);
 
-                if (twr.autoriserDecollage(avionPret)) {
-                }
-                else {
-                    twr.libererPiste();
-                }
-            }
-        }
+    // autoriserDecollage vérifie que la piste attribuée à l'avion est libre
+    for (Avion* avion : prets) {
+        if (twr.estUrgenceEnCours()) break;
+        twr.autoriserDecollage(avion);
     }
 }
 
+int pasSansUrgence(const FluxAleatoire& alea, int pasMax) {
+    int pas = 0;
+    while (pas < pasMax && alea.apercuEntier(static_cast<size_t>(pas), PROBA_URGENCE) != 0) ++pas;
+    return pas;
+}
+
 void routine_app(APP& app) {
-    while (true) {
+    HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
+    HorlogeSimulation& horloge = HorlogeSimulation::getInstance();
+    while (simulation_en_cours()) {
         app.mettreAJour();
-        simuler_pause(500);
+        horloge.attendreSignal(app.getSignal(), app.delaiReveil(DELAI_SECURITE_CONTROLEUR_MS));
     }
 }
 
 
-void routine_avion(Avion& avion, Aeroport& depart, Aeroport& arrivee, CCR& ccr, std::vector<Aeroport*> aeroports) {
+PasPilote commencer_pas_avion(PiloteAvion& pilote) {
+    Avion& avion = *pilote.avion;
+    PasPilote pas;
+    pas.etat = avion.getEtat();
+
+    if (pas.etat == EtatAvion::TERMINE) {
+        pas.attenteMs = 0;
+        return pas;
+    }
+
+    // Avion en file de décollage : il attend que la TWR le fasse rouler
+    if (pas.etat == EtatAvion::EN_ATTENTE_DECOLLAGE) {
+        pas.attenteMs = 200;
+        return pas;
+    }
+
+    if (pilote.escale == PhaseEscale::EVACUATION) {
+        avion.setEtat(EtatAvion::TERMINE);
+        pilote.escale = PhaseEscale::AUCUNE;
+        pas.attenteMs = PERIODE_PILOTE_MS;
+        return pas;
+    }
 
-    Aeroport* aeroDepart = &depart;
-    Aeroport* aeroArrivee = &arrivee;
+    pas.urgenceAvant = avion.estEnUrgence();
 
-    APP* appArrivee = aeroArrivee->app;
-    TWR* twrArrivee = aeroArrivee->twr;
+    if (pas.etat == EtatAvion::ROULE_VERS_PARKING || pas.etat == EtatAvion::ROULE_VERS_PISTE) {
+        pas.mouvement = MouvementPilote::SOL;
+    }
+    else if (pas.etat != EtatAvion::STATIONNE && pas.etat != EtatAvion::EN_ATTENTE_PISTE) {
+        pas.mouvement = MouvementPilote::VOL;
+    }
+    return pas;
+}
 
-    float dt = 1.f;
+int pas_avion(PiloteAvion& pilote) {
+    PasPilote pas = commencer_pas_avion(pilote);
+    if (pas.attenteMs >= 0) return pas.attenteMs;
 
-    while (avion.getEtat() != EtatAvion::TERMINE) {
+    if (pas.mouvement == MouvementPilote::SOL) pilote.avion->avancerSol(DT_PILOTE);
+    else if (pas.mouvement == MouvementPilote::VOL) pilote.avion->avancer(DT_PILOTE);
 
-        EtatAvion etat = avion.getEtat();
+    return terminer_pas_avion(pilote, pas);
+}
 
-        if (etat == EtatAvion::ROULE_VERS_PARKING || etat == EtatAvion::ROULE_VERS_PISTE) {
-            avion.avancerSol(dt);
-        }
-        else if (etat != EtatAvion::STATIONNE && etat != EtatAvion::EN_ATTENTE_DECOLLAGE && etat != EtatAvion::EN_ATTENTE_PISTE) {
-            avion.avancer(dt);
-        }
+int terminer_pas_avion(PiloteAvion& pilote, const PasPilote& pas) {
+    Avion& avion = *pilote.avion;
+    APP* appArrivee = pilote.aeroArrivee->app;
+    TWR* twrArrivee = pilote.aeroArrivee->twr;
+    EtatAvion etat = pas.etat;
 
-        if (etat == EtatAvion::EN_APPROCHE) {
-            if (avion.getTrajectoire().empty()) {
-                bool autorise = appArrivee->demanderAutorisationAtterrissage(&avion);
-                if (!autorise) appArrivee->mettreEnAttente(&avion);
-            }
+    // Arrivé au seuil : la TWR peut autoriser le décollage, et son parking est libre pour l'APP
+    if (etat == EtatAvion::ROULE_VERS_PISTE && avion.getEtat() == EtatAvion::EN_ATTENTE_PISTE) {
+        pilote.aeroDepart->twr->signaler();
+    }
+
+    if (etat == EtatAvion::EN_APPROCHE) {
+        if (avion.trajectoireTerminee()) {
+            bool autorise = appArrivee->demanderAutorisationAtterrissage(&avion);
+            if (!autorise) appArrivee->mettreEnAttente(&avion);
         }
+    }
 
-        else if (etat == EtatAvion::ATTERRISSAGE) {
-            if (avion.getTrajectoire().empty()) {
-                Parking* p = twrArrivee->choisirParkingLibre();
+    else if (etat == EtatAvion::ATTERRISSAGE) {
+        if (avion.trajectoireTerminee()) {
+            Parking* p = twrArrivee->reserverParking(&avion);
 
-                if (p) {
-                    p->occuper();
-                    twrArrivee->attribuerParking(&avion, p);
-                    twrArrivee->gererRoulageVersParking(&avion, p);
-                    twrArrivee->libererPiste();
-                }
-                else {
-                    std::cout << "[TWR] " << avion.getNom() << " bloque la piste (Pas de parking). Evacuation des passagers et annulation du vol.\n";
-                    twrArrivee->libererPiste();
+            if (p) {
+                twrArrivee->attribuerParking(&avion, p);
+                twrArrivee->gererRoulageVersParking(&avion, p);
+                twrArrivee->libererPiste(&avion);
+            }
+            else {
+                std::cout << "[TWR] " << avion.getNom() << " bloque la piste (Pas de parking). Evacuation des passagers et annulation du vol.\n";
+                twrArrivee->libererPiste(&avion);
 
-                    simuler_pause(3000); // temps que les passagers descendent
-                    avion.setEtat(EtatAvion::TERMINE);
-                }
+                pilote.escale = PhaseEscale::EVACUATION;
+                return 3000; // temps que les passagers descendent
             }
         }
+    }
 
-        else if (etat == EtatAvion::STATIONNE) {
+    else if (etat == EtatAvion::STATIONNE) {
 
-            simuler_pause(3000);
+        if (pilote.escale == PhaseEscale::AUCUNE) {
+            pilote.escale = PhaseEscale::MAINTENANCE;
+            return 3000;
+        }
+
+        if (pilote.escale == PhaseEscale::MAINTENANCE) {
+            pilote.escale = PhaseEscale::DEPART;
             if (avion.estEnUrgence()) {
                 if (avion.getTypeUrgence() == TypeUrgence::PANNE_MOTEUR) {
-                    Logger::getInstance().log("MAINTENANCE", "Reparation", "Moteur en cours de reparation sur " + avion.getNom());
-                    simuler_pause(5000);
+                    Logger::getInstance().evenement(ActeurLog::MAINTENANCE, ActionLog::REPARATION, avion.getId());
+                    return 5000;
                 }
                 else if (avion.getTypeUrgence() == TypeUrgence::MEDICAL) {
-                    Logger::getInstance().log("MAINTENANCE", "Evacuation", "Passager malade debarque de " + avion.getNom());
-                    simuler_pause(2000);
+                    Logger::getInstance().evenement(ActeurLog::MAINTENANCE, ActionLog::EVACUATION, avion.getId());
+                    return 2000;
                 }
             }
-            avion.effectuerMaintenance();
-
-            Aeroport* nouvelleDestination = aeroArrivee;
-            do {
-                int idx = std::rand() % aeroports.size();
-                nouvelleDestination = aeroports[idx];
-            } while (nouvelleDestination == aeroArrivee);
-
-            aeroDepart = aeroArrivee;
-            aeroArrivee = nouvelleDestination;
+        }
 
-            appArrivee = aeroArrivee->app;
+        pilote.escale = PhaseEscale::AUCUNE;
+        avion.effectuerMaintenance();
 
-            TWR* twrActuelle = aeroDepart->twr;
+        // Prochaine destination tirée parmi les aéroports qui ont un parking à la taille de l'avion
+        // (s'il n'y en a aucun autre, parmi tous)
+        const std::vector<Aeroport*>& aeroports = *pilote.aeroports;
+        CategorieAvion categorie = avion.getCategorie();
+        bool filtrer = std::any_of(aeroports.begin(), aeroports.end(), [&](const Aeroport* aero) {
+            return aero != pilote.aeroArrivee && aero->accepte(categorie);
+        });
+        Aeroport* nouvelleDestination = pilote.aeroArrivee;
+        do {
+            int idx = pilote.alea.entier(static_cast<int>(aeroports.size()));
+            nouvelleDestination = aeroports[idx];
+        } while (nouvelleDestination == pilote.aeroArrivee || (filtrer && !nouvelleDestination->accepte(categorie)));
 
-            avion.setDestination(aeroArrivee); 
-            std::cout << "[AVION] " << avion.getNom() << " : Nouveau plan de vol vers " << aeroArrivee->nom << ".\n";
+        pilote.aeroDepart = pilote.aeroArrivee;
+        pilote.aeroArrivee = nouvelleDestination;
 
-            twrActuelle->enregistrerPourDecollage(&avion);
+        TWR* twrActuelle = pilote.aeroDepart->twr;
 
-            while (avion.getEtat() == EtatAvion::EN_ATTENTE_DECOLLAGE) {
-                simuler_pause(200);
-            }
-        }
-        else if (etat == EtatAvion::DECOLLAGE) {
-            TWR* twrActuelle = aeroDepart->twr;
+        avion.setDestination(pilote.aeroArrivee); 
+        std::cout << "[AVION] " << avion.getNom() << " : Nouveau plan de vol vers " << pilote.aeroArrivee->nom << ".\n";
 
-            if (avion.getPosition().getAltitude() > 2000) {
-                twrActuelle->retirerAvionDeDecollage(&avion);
+        twrActuelle->enregistrerPourDecollage(&avion);
+        return 200;
+    }
+    else if (etat == EtatAvion::DECOLLAGE) {
+        TWR* twrActuelle = pilote.aeroDepart->twr;
 
-                std::cout << "[AVION] " << avion.getNom() << " quitte la zone et passe en CROISIERE.\n";
+        if (avion.getPosition().getAltitude() > 2000) {
+            twrActuelle->retirerAvionDeDecollage(&avion);
 
-                ccr.prendreEnCharge(&avion);
+            std::cout << "[AVION] " << avion.getNom() << " quitte la zone et passe en CROISIERE.\n";
 
-                twrArrivee = aeroArrivee->twr;
-                appArrivee = aeroArrivee->app; 
-            }
+            pilote.ccr->prendreEnCharge(&avion);
         }
+    }
 
-        if (etat == EtatAvion::EN_ROUTE || etat == EtatAvion::EN_APPROCHE) {
-            if (!avion.estEnUrgence() && (rand() % PROBA_URGENCE == 0)) {
-                if (rand() % 2 == 0) {
-                    avion.declarerUrgence(TypeUrgence::MEDICAL);
-                }
-                else {
-                    avion.declarerUrgence(TypeUrgence::PANNE_MOTEUR);
-                }
+    if ((etat == EtatAvion::EN_ROUTE || etat == EtatAvion::EN_APPROCHE) && !avion.estEnUrgence()) {
+        // Un tirage par pas, dans tous les modes (voir pasSansUrgence pour le moteur à événements)
+        if (pilote.alea.entier(PROBA_URGENCE) == 0) {
+            if (pilote.alea.entier(2) == 0) {
+                avion.declarerUrgence(TypeUrgence::MEDICAL);
+            }
+            else {
+                avion.declarerUrgence(TypeUrgence::PANNE_MOTEUR);
             }
         }
+    }
+
+    // Urgence déclarée pendant ce pas (tirage ou carburant) : l'APP d'arrivée la traite sans attendre
+    if (!pas.urgenceAvant && avion.estEnUrgence()) appArrivee->signaler();
+
+    return PERIODE_PILOTE_MS;
+}
+
+void rendre_avion(PiloteAvion& pilote) {
+    // Écrasé ou en panne sèche : sa piste, son créneau d'arrivée et sa place dans la file de
+    // décollage sont rendus tout de suite, sans attendre le recyclage
+    if (pilote.aeroDepart) pilote.aeroDepart->twr->oublier(pilote.avion);
+    if (pilote.aeroArrivee && pilote.aeroArrivee != pilote.aeroDepart) pilote.aeroArrivee->twr->oublier(pilote.avion);
+    if (pilote.registre) pilote.registre->retirer(pilote.poignee);
+    pilote.avion = nullptr;
+}
+
+void routine_avion(PiloteAvion pilote) {
+    HorlogeSimulation::Participant participant(HorlogeSimulation::adopter);
 
-        simuler_pause(75);
+    Avion& avion = *pilote.avion;
+    while (avion.getEtat() != EtatAvion::TERMINE && simulation_en_cours()) {
+        simuler_pause(pas_avion(pilote));
     }
+    // À l'arrêt de la simulation, c'est Scenario::arreter qui libère les avions
+    if (avion.getEtat() == EtatAvion::TERMINE) rendre_avion(pilote);
 }
@@ -2,10 +2,82 @@
 #include <thread>
 #include <chrono>
 #include "avion.hpp" 
+#include "aleatoire.hpp"
+#include "registreavions.hpp"
 
-void routine_avion(Avion& avion, Aeroport& depart, Aeroport& arrivee, CCR& ccr, std::vector<Aeroport*> aeroports);
+// Périodes des routines, en millisecondes de temps simulé (voir HorlogeSimulation)
+constexpr int PERIODE_PILOTE_MS = 75;
+constexpr int PERIODE_CCR_MS = 50;
+// La TWR et l'APP dorment jusqu'à un signal (file, piste, parking, urgence...) ;
+// ce délai ne sert que de filet de sécurité pour un changement qui n'aurait pas été signalé.
+constexpr int DELAI_SECURITE_CONTROLEUR_MS = 5000;
+
+// Un tick pilote (PERIODE_PILOTE_MS de temps simulé) fait avancer la physique d'un pas DT_PILOTE :
+// les vitesses et consommations d'Avion sont exprimées par pas, quel que soit le facteur de l'horloge.
+constexpr float DT_PILOTE = 1.f;
+
+// Sous-étapes d'une escale ou d'une annulation, rendues à l'appelant sous forme d'attente
+enum class PhaseEscale {
+    AUCUNE,
+    MAINTENANCE,
+    DEPART,
+    EVACUATION
+};
+
+// Contexte d'un pilote entre deux pas de sa machine à états
+struct PiloteAvion {
+    Avion* avion = nullptr;
+    Aeroport* aeroDepart = nullptr;
+    Aeroport* aeroArrivee = nullptr;
+    CCR* ccr = nullptr;
+    const std::vector<Aeroport*>* aeroports = nullptr;
+    PhaseEscale escale = PhaseEscale::AUCUNE;
+    FluxAleatoire alea;   // urgences (un tirage par pas en vol) et destinations après escale
+    // Registre propriétaire de l'avion (nullptr : l'appelant le gère lui-même), voir rendre_avion
+    RegistreAvions* registre = nullptr;
+    PoigneeAvion poignee;
+};
+
+// Exécute un pas du pilote sans jamais dormir ; renvoie le temps simulé (ms) avant le pas suivant
+int pas_avion(PiloteAvion& pilote);
+// Le pilote lâche son avion TERMINE : oublié des TWR de départ et d'arrivée, retiré du registre,
+// qui pourra le recycler ; avion remis à nullptr
+void rendre_avion(PiloteAvion& pilote);
+
+// Déplacement d'un pas pilote, fait entre ses deux moitiés
+enum class MouvementPilote {
+    AUCUN,
+    VOL,    // Avion::avancer
+    SOL     // Avion::avancerSol
+};
+
+struct PasPilote {
+    EtatAvion etat = EtatAvion::STATIONNE;
+    bool urgenceAvant = false;
+    MouvementPilote mouvement = MouvementPilote::AUCUN;
+    int attenteMs = -1;     // positif ou nul : le pas s'arrête là, attente avant le suivant
+};
+
+// pas_avion en deux moitiés autour du déplacement, pour qu'un ordonnanceur déplace ensemble
+// tous les avions d'un tick (Avion::avancerGroupe) : commencer, déplacer, puis terminer
+PasPilote commencer_pas_avion(PiloteAvion& pilote);
+int terminer_pas_avion(PiloteAvion& pilote, const PasPilote& pas);
+// Nombre de pas en vol, au plus pasMax, dont le tirage d'urgence à venir dans alea ne déclenche
+// rien : ces pas peuvent être sautés en consommant leurs tirages (FluxAleatoire::sauter), et
+// l'urgence tombe alors au même pas, pour la même graine, qu'en jouant chaque pas
+int pasSansUrgence(const FluxAleatoire& alea, int pasMax);
+// Un passage de la TWR : fait rouler ou décoller le prochain avion de la file
+void pas_twr(TWR& twr);
+
+// Routines bloquantes : le thread qui les lance doit l'avoir enregistré auprès de
+// HorlogeSimulation (enregistrerParticipant) ; elles adoptent cet enregistrement.
+void routine_avion(PiloteAvion pilote);
 void routine_twr(TWR& twr);
 void routine_app(APP& app);
 void routine_ccr(CCR& ccr);
 
 void simuler_pause(int ms);
+
+// Arrêt coopératif des routines (utilisé par le pilote headless et à la fermeture du visualiseur)
+void arreter_simulation();
+bool simulation_en_cours();
@@ -1,51 +1,198 @@
 ﻿#include "avion.hpp"
-
-TWR::TWR(const std::vector<Parking>& parkings, Position posPiste, float tempsAtterrisageDecollage)
-    : pisteLibre_(true),
+#include "allocateurparkings.hpp"
+#include "filedecollage.hpp"
+#include "piste.hpp"
+#include "thread.hpp"
+#include <limits>
+
+TWR::TWR(const std::vector<Parking>& parkings, const std::vector<Position>& positionsPistes, float tempsAtterrisageDecollage)
+    : tempsAtterrissageDecollage_(tempsAtterrisageDecollage),
+    posPiste_(positionsPistes.front()),
     parkings_(parkings),
-    posPiste_(posPiste),
-    tempsAtterrissageDecollage_(tempsAtterrisageDecollage),
+    allocateur_(std::make_unique<AllocateurParkings>(parkings_, posPiste_)),
+    fileDecollage_(std::make_unique<FileDecollage>()),
+    profondeurMaxDecollage_(0), nbDecollages_(0), attenteCumuleeMs_(0), attenteMaxMs_(0),
     urgenceEnCours_(false) 
 {
+    for (size_t i = 0; i < positionsPistes.size(); ++i) {
+        pistes_.emplace_back("P" + std::to_string(i + 1), positionsPistes[i], static_cast<long long>(tempsAtterrisageDecollage));
+    }
+    decollagesParPiste_.assign(pistes_.size(), 0);
+}
+
+TWR::TWR(const std::vector<Parking>& parkings, Position posPiste, float tempsAtterrisageDecollage)
+    : TWR(parkings, std::vector<Position>{ posPiste }, tempsAtterrisageDecollage) {
 }
 
+TWR::~TWR() = default;
+
 Position TWR::getPositionPiste() const {
     std::lock_guard<std::mutex> lock(mutexTWR_);
     return posPiste_;
 }
 
+Position TWR::getPositionPiste(const Avion* avion) const {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    auto it = pisteAssignee_.find(avion);
+    if (it != pisteAssignee_.end()) return pistes_[it->second].getPosition();
+    auto creneau = creneauxArrivee_.find(avion);
+    return (creneau != creneauxArrivee_.end()) ? pistes_[creneau->second.piste].getPosition() : posPiste_;
+}
+
+size_t TWR::getNombrePistes() const {
+    return pistes_.size();
+}
+
+// Appelés sous mutexTWR_.
+// Atterrissage : parmi les pistes libres à tMs, la moins récemment utilisée (-1 si aucune).
+// Une piste où un départ attend au seuil lui est laissée.
+int TWR::choisirPisteLibre(long long tMs) {
+    int choix = -1;
+    for (size_t i = 0; i < pistes_.size(); ++i) {
+        pistes_[i].purger(tMs);
+        if (!pistes_[i].estLibre(tMs)) continue;
+        const Avion* depart = pistes_[i].getDepart();
+        if (depart && depart->getEtat() == EtatAvion::EN_ATTENTE_PISTE) continue;
+        if (choix < 0 || pistes_[i].getDerniereUtilisationMs() < pistes_[choix].getDerniereUtilisationMs()) {
+            choix = static_cast<int>(i);
+        }
+    }
+    return choix;
+}
+
+// Décollage : la piste la plus proche du parking parmi celles sans départ en cours (-1 si aucune)
+int TWR::choisirPisteDepart(const Position& parking) const {
+    int choix = -1;
+    for (size_t i = 0; i < pistes_.size(); ++i) {
+        if (pistes_[i].getDepart() != nullptr) continue;
+        if (choix < 0 || parking.distance(pistes_[i].getPosition()) < parking.distance(pistes_[choix].getPosition())) {
+            choix = static_cast<int>(i);
+        }
+    }
+    return choix;
+}
+
+// Urgence sans piste libre : celle dont le prochain créneau est le plus tôt, puis la moins récemment utilisée
+size_t TWR::choisirPisteProchaine(long long tMs) const {
+    size_t choix = 0;
+    long long meilleur = std::numeric_limits<long long>::max();
+    for (size_t i = 0; i < pistes_.size(); ++i) {
+        long long creneau = pistes_[i].prochainCreneau(tMs);
+        if (creneau < meilleur || (creneau == meilleur
+            && pistes_[i].getDerniereUtilisationMs() < pistes_[choix].getDerniereUtilisationMs())) {
+            meilleur = creneau;
+            choix = i;
+        }
+    }
+    return choix;
+}
+
 bool TWR::estPisteLibre() const {
-    return pisteLibre_;
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+    for (const Piste& piste : pistes_) {
+        if (piste.estLibre(maintenant)) return true;
+    }
+    return false;
 }
 
-void TWR::libererPiste() {
-    pisteLibre_ = true;
+void TWR::libererPiste(const Avion* avion) {
+    {
+        std::lock_guard<std::mutex> lock(mutexTWR_);
+        auto it = pisteAssignee_.find(avion);
+        if (it != pisteAssignee_.end()) {
+            pistes_[it->second].liberer(avion);
+            pisteAssignee_.erase(it);
+        }
+        // Sans parking, l'avion en urgence est évacué sur place : la piste dégagée suffit
+        if (urgenceEnCours_ && avion->estEnUrgence()) {
+            urgenceEnCours_ = false;
+            std::cout << "[TWR] L'avion en urgence a degage la piste. Reprise des decollages.\n";
+        }
+    }
+    signaler();
 }
 
-void TWR::reserverPiste() {
-    pisteLibre_ = false;
+long long TWR::delaiReveil(long long delaiMaxMs) const {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+    long long delai = delaiMaxMs;
+    for (const Piste& piste : pistes_) {
+        long long fin = piste.prochaineFin(maintenant);
+        if (fin >= 0) delai = std::min(delai, fin - maintenant);
+    }
+    return std::max(1LL, delai);
 }
 
+CreneauArrivee TWR::reserverCreneauArrivee(const Avion* avion, long long etaMs) {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+
+    auto ancien = creneauxArrivee_.find(avion);
+    if (ancien != creneauxArrivee_.end()) {
+        pistes_[ancien->second.piste].annuler(ancien->second.debutMs, avion->getId());
+    }
+
+    // Le créneau le plus tôt ; à égalité, la piste la moins récemment utilisée
+    CreneauArrivee creneau{ 0, std::numeric_limits<long long>::max() };
+    for (size_t i = 0; i < pistes_.size(); ++i) {
+        long long debut = pistes_[i].prochainCreneau(etaMs);
+        if (debut < creneau.debutMs || (debut == creneau.debutMs
+            && pistes_[i].getDerniereUtilisationMs() < pistes_[creneau.piste].getDerniereUtilisationMs())) {
+            creneau = { i, debut };
+        }
+    }
+    pistes_[creneau.piste].reserver(creneau.debutMs, avion->getId());
+    creneauxArrivee_[avion] = creneau;
+    return creneau;
+}
+
+void TWR::annulerCreneauArrivee(const Avion* avion) {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    auto it = creneauxArrivee_.find(avion);
+    if (it == creneauxArrivee_.end()) return;
+    pistes_[it->second.piste].annuler(it->second.debutMs, avion->getId());
+    creneauxArrivee_.erase(it);
+}
 
 bool TWR::autoriserAtterrissage(Avion* avion) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
 
-    bool parkingDispo = false;
-    for (const auto& p : parkings_) {
-        if (!p.estOccupe()) {
-            parkingDispo = true;
-            break;
+    long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+    bool parkingDispo = allocateur_->disponible(avion->getCategorie());
+
+    auto reservation = creneauxArrivee_.find(avion);
+    if (reservation != creneauxArrivee_.end()) {
+        CreneauArrivee creneau = reservation->second;
+        Piste& reservee = pistes_[creneau.piste];
+        creneauxArrivee_.erase(reservation);
+
+        // L'heure d'arrivée prévue est à un pas pilote près
+        bool dansCreneau = maintenant >= creneau.debutMs - PERIODE_PILOTE_MS
+            && maintenant < creneau.debutMs + reservee.getDureeOccupationMs();
+        if (dansCreneau && parkingDispo && reservee.estDegagee()) {
+            reservee.occuperCreneau(avion, creneau.debutMs);
+            pisteAssignee_[avion] = creneau.piste;
+            std::cout << "[TWR] Atterrissage AUTORISE pour " << avion->getNom() << " (Piste " << reservee.getNom() << ", creneau prevu).\n";
+            avion->setEtat(EtatAvion::ATTERRISSAGE);
+            return true;
         }
+        // Hors de son créneau : cas général
+        reservee.annuler(creneau.debutMs, avion->getId());
     }
 
-    if ((pisteLibre_ && parkingDispo) || avion->estEnUrgence()) {
-        pisteLibre_ = false;
-        std::cout << "[TWR] Atterrissage AUTORISE pour " << avion->getNom() << " (Piste reservee).\n";
+    int piste = choisirPisteLibre(maintenant);
+
+    if ((piste >= 0 && parkingDispo) || avion->estEnUrgence()) {
+        // Une urgence se pose même sur une piste occupée : celle qui se libère le plus tôt
+        if (piste < 0) piste = static_cast<int>(choisirPisteProchaine(maintenant));
+        pistes_[piste].occuper(avion, maintenant);
+        pisteAssignee_[avion] = piste;
+        std::cout << "[TWR] Atterrissage AUTORISE pour " << avion->getNom() << " (Piste " << pistes_[piste].getNom() << " reservee).\n";
         avion->setEtat(EtatAvion::ATTERRISSAGE);
         return true;
     }
 
-    if (!pisteLibre_) {
+    if (piste < 0) {
         std::cout << "[TWR] Refus atterrissage " << avion->getNom() << ": Piste occupee.\n";
     }
     else if (!parkingDispo) {
@@ -55,14 +202,16 @@ bool TWR::autoriserAtterrissage(Avion* avion) {
     return false;
 }
 
-Parking* TWR::choisirParkingLibre() {
-    std::lock_guard<std::mutex> lock(mutexTWR_);
-    for (auto& parking : parkings_) {
-        if (!parking.estOccupe()) {
-            return &parking;
-        }
-    }
-    return nullptr;
+Parking* TWR::reserverParking(const Avion* avion) {
+    return allocateur_->reserver(avion->getCategorie());
+}
+
+void TWR::setPolitiqueParking(PolitiqueParking politique) {
+    allocateur_->setPolitique(politique);
+}
+
+size_t TWR::getNombreParkingsLibres() const {
+    return allocateur_->getNombreLibres();
 }
 
 void TWR::attribuerParking(Avion* avion, Parking* parking) {
@@ -72,17 +221,14 @@ void TWR::attribuerParking(Avion* avion, Parking* parking) {
     if (avion->estEnUrgence()) {
         urgenceEnCours_ = false;
         std::cout << "[TWR] L'avion en urgence est au parking. Reprise des decollages.\n";
+        signaler();
     }
-    std::stringstream ss;
-    ss << *avion << " bloque au bloc " << parking->getNom();
-    Logger::getInstance().log("TWR", "Parking", ss.str());
+    Logger& logger = Logger::getInstance();
+    logger.evenement(ActeurLog::TWR, ActionLog::PARKING, avion->getId(), logger.symbole(parking->getNom()), avion->getCarburant());
 }
 
 void TWR::gererRoulageVersParking(Avion* avion, Parking* parking) {
-    std::vector<Position> cheminRoulage;
-    cheminRoulage.push_back(parking->getPosition());
-
-    avion->setTrajectoire(cheminRoulage);
+    avion->setTrajectoire({ parking->getPosition() });
     avion->setEtat(EtatAvion::ROULE_VERS_PARKING);
 
     std::cout << "[TWR] Roulage vers " << parking->getNom() << " (Piste -> Parking) pour " << avion->getNom() << ".\n";
@@ -90,83 +236,96 @@ void TWR::gererRoulageVersParking(Avion* avion, Parking* parking) {
 
 void TWR::enregistrerPourDecollage(Avion* avion) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
-    if (std::find(filePourDecollage_.begin(), filePourDecollage_.end(), avion) == filePourDecollage_.end()) {
-        filePourDecollage_.push_back(avion);
+    if (!fileDecollage_->contient(avion)) {
+        Parking* parking = avion->getParking();
         avion->setEtat(EtatAvion::EN_ATTENTE_DECOLLAGE);
-        std::cout << "[TWR] " << avion->getNom() << " s'enregistre pour le decollage (Position dans la file: " << filePourDecollage_.size() << ").\n";
+        fileDecollage_->ajouter(avion, FileDecollage::phasePour(EtatAvion::EN_ATTENTE_DECOLLAGE, parking != nullptr),
+            parking ? parking->getDistancePiste(posPiste_) : 0.0, HorlogeSimulation::getInstance().maintenantMs());
+        profondeurMaxDecollage_ = std::max(profondeurMaxDecollage_, fileDecollage_->taille());
+        std::cout << "[TWR] " << avion->getNom() << " s'enregistre pour le decollage (Position dans la file: " << fileDecollage_->taille() << ").\n";
+        HorlogeSimulation::getInstance().signaler(signal_);
     }
 }
 
-Avion* TWR::choisirAvionPourDecollage() const {
+void TWR::choisirAvionsPourDecollage(std::vector<Avion*>& prets) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
-
-    if (filePourDecollage_.empty()) return nullptr;
-
-    for (Avion* avion : filePourDecollage_) {
-        if (avion->getEtat() == EtatAvion::EN_ATTENTE_PISTE) {
-            return avion;
+    long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+
+    // Tant qu'une piste n'a pas de départ, le prochain avion au parking roule vers elle
+    for (;;) {
+        // Un avion au parking peut avoir changé d'état sans passer par la TWR : la tête est relue
+        // jusqu'à être à jour
+        Avion* tete = fileDecollage_->tete();
+        while (tete) {
+            FileDecollage::Phase phase = FileDecollage::phasePour(tete->getEtat(), tete->getParking() != nullptr);
+            if (phase == fileDecollage_->phaseTete()) break;
+            fileDecollage_->changerPhase(tete, phase);
+            tete = fileDecollage_->tete();
         }
+        if (!tete || fileDecollage_->phaseTete() != FileDecollage::Phase::AU_PARKING) break;
+
+        int piste = choisirPisteDepart(tete->getParking()->getPosition());
+        if (piste < 0) break;
+        double distance = tete->getParking()->getDistancePiste(pistes_[piste].getPosition());
+        pisteAssignee_[tete] = piste;
+        pistes_[piste].setDepart(tete);
+        tete->setTrajectoire({ pistes_[piste].getPosition() });
+        tete->setEtat(EtatAvion::ROULE_VERS_PISTE);
+        fileDecollage_->changerPhase(tete, FileDecollage::Phase::EN_ROULAGE);
+        std::cout << "[TWR] " << tete->getNom() << " quitte le parking vers la piste " << pistes_[piste].getNom() << " (Distance: " << (int)distance << "m).\n";
     }
 
-    for (Avion* avion : filePourDecollage_) {
-        if (avion->getEtat() == EtatAvion::ROULE_VERS_PISTE) {
-            return nullptr;
+    // Au seuil : chaque piste libre laisse partir son départ
+    for (Piste& piste : pistes_) {
+        piste.purger(maintenant);
+        Avion* depart = piste.getDepart();
+        if (depart && depart->getEtat() == EtatAvion::EN_ATTENTE_PISTE && piste.estLibre(maintenant)) {
+            prets.push_back(depart);
         }
     }
-
-    Avion* prioritaire = nullptr;
-    double maxDistance = -1.0;
-
-    for (Avion* avion : filePourDecollage_) {
-        if (avion->getEtat() == EtatAvion::EN_ATTENTE_DECOLLAGE) {
-            Parking* parking = avion->getParking();
-            if (parking) {
-                double distance = parking->getDistancePiste(posPiste_);
-                if (distance > maxDistance) {
-                    maxDistance = distance;
-                    prioritaire = avion;
-                }
-            }
-        }
-    }
-
-    if (prioritaire) {
-        std::vector<Position> cheminRoulage;
-        cheminRoulage.push_back(posPiste_);
-        prioritaire->setTrajectoire(cheminRoulage);
-
-        prioritaire->setEtat(EtatAvion::ROULE_VERS_PISTE);
-        std::cout << "[TWR] " << prioritaire->getNom() << " quitte le parking vers la piste (Distance: " << (int)maxDistance << "m).\n";
-
-        return nullptr;
-    }
-
-    return nullptr;
 }
 
 bool TWR::autoriserDecollage(Avion* avion) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
 
+    // pas_twr relâche le verrou entre le choix et l'autorisation : l'avion a pu être oublié entre-temps
+    if (!fileDecollage_->contient(avion)) return false;
+
     if (urgenceEnCours_) {
         std::cout << "[TWR] Decollage refuse pour " << avion->getNom() << " (Priorite a l'urgence).\n";
         return false;
     }
 
     if (avion->getEtat() == EtatAvion::EN_ATTENTE_PISTE) {
-        std::cout << "[TWR] Decollage AUTORISE pour " << avion->getNom() << ". Bon vol !\n";
+        long long maintenant = HorlogeSimulation::getInstance().maintenantMs();
+        auto assignee = pisteAssignee_.find(avion);
+        size_t piste = (assignee != pisteAssignee_.end()) ? assignee->second : 0;
+        pistes_[piste].purger(maintenant);
+        if (!pistes_[piste].estLibre(maintenant)) return false;
+
+        pistes_[piste].occuper(avion, maintenant);
+        if (pistes_[piste].getDepart() == avion) pistes_[piste].setDepart(nullptr);
+        pisteAssignee_[avion] = piste;
+        ++decollagesParPiste_[piste];
+        std::cout << "[TWR] Decollage AUTORISE pour " << avion->getNom() << " (piste " << pistes_[piste].getNom() << "). Bon vol !\n";
 
-        std::vector<Position> trajMontee;
         Position actuelle = avion->getPosition();
         
         // Modification : Montée progressive vers 3000m sur 20km
-        trajMontee.push_back(Position(actuelle.getX(), actuelle.getY() + 20000, 3000));
-
-        avion->setTrajectoire(trajMontee);
+        avion->setTrajectoire({ Position(actuelle.getX(), actuelle.getY() + 20000, 3000) });
         avion->setEtat(EtatAvion::DECOLLAGE);
+        fileDecollage_->changerPhase(avion, FileDecollage::Phase::HORS_SEQUENCE);
+
+        long long enregistrement = fileDecollage_->enregistrementMs(avion);
+        if (enregistrement >= 0) {
+            long long attente = HorlogeSimulation::getInstance().maintenantMs() - enregistrement;
+            ++nbDecollages_;
+            attenteCumuleeMs_ += attente;
+            attenteMaxMs_ = std::max(attenteMaxMs_, attente);
+        }
 
-        std::stringstream ss;
-        ss << "Decollage immediat piste " << (int)posPiste_.getX() << " pour " << *avion;
-        Logger::getInstance().log("TWR", "Decollage", ss.str());
+        Logger::getInstance().evenement(ActeurLog::TWR, ActionLog::DECOLLAGE, avion->getId(), 0,
+            avion->getCarburant(), (float)pistes_[piste].getPosition().getX());
 
         return true;
     }
@@ -176,21 +335,67 @@ bool TWR::autoriserDecollage(Avion* avion) {
 void TWR::retirerAvionDeDecollage(Avion* avion) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
 
-    auto it = std::find(filePourDecollage_.begin(), filePourDecollage_.end(), avion);
-
-    if (it != filePourDecollage_.end()) {
-        filePourDecollage_.erase(it);
-        pisteLibre_ = true;
+    if (fileDecollage_->retirer(avion)) {
+        auto it = pisteAssignee_.find(avion);
+        if (it != pisteAssignee_.end()) {
+            pistes_[it->second].liberer(avion);
+            pisteAssignee_.erase(it);
+        }
         std::cout << "[TWR] Piste liberee apres le decollage de " << avion->getNom() << ".\n";
+        signaler();
+    }
+}
+
+void TWR::oublier(const Avion* avion) {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    fileDecollage_->retirer(avion);
+    pisteAssignee_.erase(avion);
+
+    auto creneau = creneauxArrivee_.find(avion);
+    if (creneau != creneauxArrivee_.end()) {
+        pistes_[creneau->second.piste].annuler(creneau->second.debutMs, avion->getId());
+        creneauxArrivee_.erase(creneau);
     }
+
+    for (Piste& piste : pistes_) piste.oublier(avion);
+}
+
+StatistiquesDecollage TWR::getStatistiquesDecollage() const {
+    std::lock_guard<std::mutex> lock(mutexTWR_);
+    StatistiquesDecollage stats;
+    stats.profondeur = fileDecollage_->taille();
+    stats.profondeurMax = profondeurMaxDecollage_;
+    stats.nbDecollages = nbDecollages_;
+    stats.attenteMoyenneMs = nbDecollages_ ? static_cast<double>(attenteCumuleeMs_) / nbDecollages_ : 0.0;
+    stats.attenteMaxMs = attenteMaxMs_;
+    stats.decollagesParPiste = decollagesParPiste_;
+    return stats;
 }
 
 void TWR::setUrgenceEnCours(bool statut) {
     std::lock_guard<std::mutex> lock(mutexTWR_);
     urgenceEnCours_ = statut;
+    if (!statut) signaler();
 }
 
 bool TWR::estUrgenceEnCours() const {
     std::lock_guard<std::mutex> lock(mutexTWR_);
     return urgenceEnCours_;
 }
+
+SignalHorloge& TWR::getSignal() {
+    return signal_;
+}
+
+// À appeler à la construction, avant le démarrage des routines
+void TWR::abonner(SignalHorloge* signal) {
+    abonnes_.push_back(signal);
+}
+
+void TWR::signaler() {
+    HorlogeSimulation& horloge = HorlogeSimulation::getInstance();
+    horloge.signaler(signal_);
+    for (SignalHorloge* abonne : abonnes_) {
+        horloge.signaler(*abonne);
+    }
+}